@@ -1,9 +1,18 @@
 #include <iostream>
 #include <vector>
 #include <queue>       // For std::priority_queue (used in Prim's)
+#include <tuple>
 #include <algorithm>   // For std::sort (used in Kruskal's)
-#include <numeric>     // For std::iota (used in DSU)
 #include <limits>
+#include <string>
+#include <fstream>     // For CompactGraph's binary edge files
+#include <cstring>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <atomic>      // For ConcurrentDSU
+#include <thread>      // For the parallel drivers
 
 const int INF = std::numeric_limits<int>::max();
 
@@ -25,110 +34,608 @@ public:
     // Used primarily for Prim's Algorithm
     std::vector<std::vector<std::pair<int, int>>> adj;
 
+    // adjEdge[u][k] is the index in `edges` of the edge behind adj[u][k]
+    // Lets Prim's report which edges it chose
+    std::vector<std::vector<int>> adjEdge;
+
     // Edge list representation: vector of all edges
     // Used primarily for Kruskal's Algorithm
     std::vector<Edge> edges;
 
     Graph(int vertices) : V(vertices) {
         adj.resize(V);
+        adjEdge.resize(V);
     }
 
     // Add an undirected edge to the graph
     void addEdge(int u, int v, int w) {
+        int index = static_cast<int>(edges.size());
         adj[u].push_back({v, w});
         adj[v].push_back({u, w});
+        adjEdge[u].push_back(index);
+        adjEdge[v].push_back(index);
         edges.push_back({u, v, w});
     }
 };
 
+/**
+ * Build-once graph that stores every undirected edge exactly once, in
+ * struct-of-arrays columns (src[e], dst[e], weight[e]). Edge e here plays
+ * the role of graph.edges[e] in Graph. Prim's needs adjacency, which is
+ * derived on demand as a CSR index (see buildAdjacency) instead of being
+ * kept in per-vertex vectors.
+ */
+class CompactGraph {
+public:
+    int V; // Number of vertices
+
+    std::vector<int> src;
+    std::vector<int> dst;
+    std::vector<int> weight;
+
+    // CSR adjacency: the edges at u are adjEdgeId[adjOffset[u] .. adjOffset[u + 1]).
+    // The far end is not stored; neighbour(u, e) derives it from the columns,
+    // so the index costs 8 bytes per edge on top of the 12 of the columns.
+    // Empty until buildAdjacency().
+    std::vector<size_t> adjOffset;
+    std::vector<int> adjEdgeId;
+
+    CompactGraph(int vertices, size_t expectedEdges = 0) : V(vertices) {
+        src.reserve(expectedEdges);
+        dst.reserve(expectedEdges);
+        weight.reserve(expectedEdges);
+    }
+
+    size_t numEdges() const {
+        return src.size();
+    }
+
+    // Add an undirected edge. Invalidates any CSR index already built.
+    void addEdge(int u, int v, int w) {
+        if (u < 0 || u >= V || v < 0 || v >= V) {
+            throw std::out_of_range("Vertex index out of range in CompactGraph::addEdge.");
+        }
+        src.push_back(u);
+        dst.push_back(v);
+        weight.push_back(w);
+        adjOffset.clear();
+    }
+
+    bool hasAdjacency() const {
+        return !adjOffset.empty();
+    }
+
+    // The endpoint of edge e that is not u (u itself for a self-loop).
+    int neighbour(int u, int e) const {
+        return src[e] == u ? dst[e] : src[e];
+    }
+
+    // Builds the CSR index with a counting pass, a prefix sum and a fill pass.
+    void buildAdjacency() {
+        size_t m = numEdges();
+        adjOffset.assign(static_cast<size_t>(V) + 1, 0);
+        for (size_t e = 0; e < m; e++) {
+            adjOffset[src[e] + 1]++;
+            adjOffset[dst[e] + 1]++;
+        }
+        for (int u = 0; u < V; u++) {
+            adjOffset[u + 1] += adjOffset[u];
+        }
+
+        adjEdgeId.resize(2 * m);
+        std::vector<size_t> cursor(adjOffset.begin(), adjOffset.end() - 1);
+        for (size_t e = 0; e < m; e++) {
+            adjEdgeId[cursor[src[e]]++] = static_cast<int>(e);
+            adjEdgeId[cursor[dst[e]]++] = static_cast<int>(e);
+        }
+    }
+
+    /**
+     * Binary edge file layout (native byte order):
+     *   char magic[4] = "EDGE", uint32 version = 1, int64 vertices, uint64 edges,
+     *   then `edges` records of {int32 src, int32 dst, int32 weight}.
+     */
+    static CompactGraph loadBinaryEdgeFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Cannot open edge file: " + path);
+        }
+
+        char magic[4];
+        uint32_t version = 0;
+        int64_t vertices = 0;
+        uint64_t edgeCount = 0;
+        in.read(magic, 4);
+        in.read(reinterpret_cast<char*>(&version), sizeof(version));
+        in.read(reinterpret_cast<char*>(&vertices), sizeof(vertices));
+        in.read(reinterpret_cast<char*>(&edgeCount), sizeof(edgeCount));
+        if (!in || std::memcmp(magic, "EDGE", 4) != 0 || version != 1 ||
+            vertices < 0 || vertices > std::numeric_limits<int>::max() ||
+            edgeCount > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+            throw std::runtime_error("Not a valid edge file: " + path);
+        }
+
+        CompactGraph graph(static_cast<int>(vertices), edgeCount);
+        graph.src.resize(edgeCount);
+        graph.dst.resize(edgeCount);
+        graph.weight.resize(edgeCount);
+
+        // Read fixed-size chunks of records and scatter them into the columns.
+        const size_t chunkRecords = 1 << 16;
+        std::vector<int32_t> buffer(3 * chunkRecords);
+        for (uint64_t done = 0; done < edgeCount;) {
+            size_t count = static_cast<size_t>(std::min<uint64_t>(chunkRecords, edgeCount - done));
+            in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(count * 3 * sizeof(int32_t)));
+            if (!in) {
+                throw std::runtime_error("Edge file is truncated: " + path);
+            }
+            for (size_t k = 0; k < count; k++) {
+                int u = buffer[3 * k];
+                int v = buffer[3 * k + 1];
+                if (u < 0 || u >= graph.V || v < 0 || v >= graph.V) {
+                    throw std::runtime_error("Edge file references a vertex out of range: " + path);
+                }
+                graph.src[done + k] = u;
+                graph.dst[done + k] = v;
+                graph.weight[done + k] = buffer[3 * k + 2];
+            }
+            done += count;
+        }
+
+        return graph;
+    }
+
+    // Writes this graph in the format read by loadBinaryEdgeFile.
+    void saveBinaryEdgeFile(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot open edge file for writing: " + path);
+        }
+
+        uint32_t version = 1;
+        int64_t vertices = V;
+        uint64_t edgeCount = numEdges();
+        out.write("EDGE", 4);
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&vertices), sizeof(vertices));
+        out.write(reinterpret_cast<const char*>(&edgeCount), sizeof(edgeCount));
+
+        const size_t chunkRecords = 1 << 16;
+        std::vector<int32_t> buffer(3 * chunkRecords);
+        for (size_t done = 0; done < edgeCount;) {
+            size_t count = std::min<size_t>(chunkRecords, edgeCount - done);
+            for (size_t k = 0; k < count; k++) {
+                buffer[3 * k] = src[done + k];
+                buffer[3 * k + 1] = dst[done + k];
+                buffer[3 * k + 2] = weight[done + k];
+            }
+            out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(count * 3 * sizeof(int32_t)));
+            done += count;
+        }
+
+        if (!out) {
+            throw std::runtime_error("Failed to write edge file: " + path);
+        }
+    }
+};
+
 /**
  * Disjoint Set Union (DSU) or Union-Find data structure.
  * Required for Kruskal's algorithm to efficiently detect cycles.
+ *
+ * Packed layout: a single int per element.
+ *   parent[i] >= 0  -> i is a child of parent[i]
+ *   parent[i] <  0  -> i is a root and -parent[i] is its set size
+ * Union by size keeps trees O(log n) deep and `find` is iterative with
+ * path halving, so there is no recursion to overflow on long chains.
  */
 class DSU {
     std::vector<int> parent;
+    int components;
 
 public:
-    DSU(int n) {
-        parent.resize(n);
-        // TODO: Initialize the DSU structure.
-        // Hint: Set each element's parent to itself.
-        // (std::iota(parent.begin(), parent.end(), 0) is a quick way)
-
-        std::iota(parent.begin(), parent.end(), 0);
-    }
+    DSU(int n) : parent(n, -1), components(n) {}
 
     /**
      * Finds the representative (root) of the set that element i belongs to.
-     * Should implement path compression for efficiency.
+     * Path halving: every visited node is re-pointed at its grandparent.
      */
     int find(int i) {
-        // TODO: Implement the 'find' operation with path compression.
-        //
-        // 1. If parent[i] is i, then i is the root. Return i.
-        // 2. Otherwise, recursively call find(parent[i]) and set
-        //    parent[i] to the result before returning it.
+        while (parent[i] >= 0) {
+            int p = parent[i];
+            if (parent[p] >= 0) {
+                parent[i] = parent[p];
+            }
+            i = parent[i];
+        }
+        return i;
+    }
 
-        if (parent[i] == i)
-        {
-            return i;
+    /**
+     * Merges the two sets that x and y belong to, hanging the smaller tree
+     * under the larger one.
+     * @return true if x and y were in different sets.
+     */
+    bool unite(int x, int y) {
+        int rootX = find(x);
+        int rootY = find(y);
+
+        if (rootX == rootY) {
+            return false;
         }
 
-        parent[i] = find(parent[i]);
+        if (parent[rootX] > parent[rootY]) { // rootX is the smaller set
+            std::swap(rootX, rootY);
+        }
+        parent[rootX] += parent[rootY];
+        parent[rootY] = rootX;
+        components--;
+        return true;
+    }
+
+    bool connected(int x, int y) {
+        return find(x) == find(y);
+    }
+
+    int componentSize(int i) {
+        return -parent[find(i)];
+    }
+
+    int componentCount() const {
+        return components;
+    }
+};
+
+/**
+ * Number of chunks parallelFor(count, numThreads, ...) will use. Thread
+ * index t always gets the same [begin, end) for a given count and thread
+ * count, so callers can size per-thread scratch with this.
+ */
+inline unsigned parallelForThreads(size_t count, unsigned numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const size_t minChunk = 4096;
+    return std::max(1u, static_cast<unsigned>(std::min<size_t>(numThreads, (count + minChunk - 1) / minChunk)));
+}
+
+/**
+ * Splits [0, count) into one contiguous chunk per thread and runs
+ * body(begin, end, threadIndex) on each. numThreads == 0 means "use all
+ * hardware threads"; small inputs run inline on the calling thread.
+ */
+template <typename Body>
+void parallelFor(size_t count, unsigned numThreads, Body body) {
+    numThreads = parallelForThreads(count, numThreads);
+
+    if (numThreads <= 1) {
+        body(size_t(0), count, 0u);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads - 1);
+    size_t chunk = (count + numThreads - 1) / numThreads;
+    for (unsigned t = 1; t < numThreads; t++) {
+        size_t begin = std::min(count, t * chunk);
+        size_t end = std::min(count, begin + chunk);
+        workers.emplace_back(body, begin, end, t);
+    }
+    body(size_t(0), std::min(count, chunk), 0u);
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
 
-        return parent[i]; 
+/**
+ * Lock-free Union-Find that any number of threads may use at once.
+ * Roots are linked by index order (larger index under smaller) with a CAS,
+ * so parent[i] <= i always holds and no cycle can form. `find` does path
+ * splitting with a relaxed CAS; a lost race only means less compression.
+ */
+class ConcurrentDSU {
+    std::vector<std::atomic<int>> parent;
+
+public:
+    ConcurrentDSU(int n) : parent(n) {
+        for (int i = 0; i < n; i++) {
+            parent[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+    int find(int i) {
+        while (true) {
+            int p = parent[i].load(std::memory_order_acquire);
+            if (p == i) {
+                return i;
+            }
+            int grandparent = parent[p].load(std::memory_order_acquire);
+            if (p != grandparent) {
+                parent[i].compare_exchange_weak(p, grandparent, std::memory_order_relaxed);
+            }
+            i = p;
+        }
     }
 
     /**
-     * Merges the two sets that x and y belong to.
+     * Merges the sets of x and y.
+     * @return true if this call performed the merge.
      */
-    void unite(int x, int y) {
-        // TODO: Implement the 'unite' (or union) operation.
-        //
-        // 1. Find the root of x (call it rootX).
-        // 2. Find the root of y (call it rootY).
-        // 3. If rootX is not equal to rootY, merge them by setting
-        //    the parent of one root to the other (e.g., parent[rootX] = rootY).
+    bool unite(int x, int y) {
+        while (true) {
+            x = find(x);
+            y = find(y);
+            if (x == y) {
+                return false;
+            }
+            if (x < y) {
+                std::swap(x, y);
+            }
+            int expected = x;
+            if (parent[x].compare_exchange_strong(expected, y, std::memory_order_acq_rel)) {
+                return true;
+            }
+            // x stopped being a root under us; retry from the new roots.
+        }
+    }
 
-        int rootX = find(x);
-        int rootY = find(y);
+    bool connected(int x, int y) {
+        while (true) {
+            x = find(x);
+            y = find(y);
+            if (x == y) {
+                return true;
+            }
+            // Only trust "different" if x is still a root after finding y.
+            if (parent[x].load(std::memory_order_acquire) == x) {
+                return false;
+            }
+        }
+    }
+};
+
+/**
+ * Binary min-heap over vertex ids 0..n-1 with a position map, so a vertex's
+ * key can be decreased in place. Holds at most n entries, unlike a lazy
+ * priority_queue that grows with the number of edges relaxed.
+ * Ties are broken by the lower vertex id.
+ */
+class IndexedMinHeap {
+    std::vector<int> heap; // Vertex ids in heap order
+    std::vector<int> pos;  // pos[v] = index of v in `heap`, or -1
+    std::vector<int> key;
+
+    bool less(int a, int b) const {
+        return key[a] < key[b] || (key[a] == key[b] && a < b);
+    }
+
+    void place(int index, int v) {
+        heap[index] = v;
+        pos[v] = index;
+    }
 
-        if (rootX != rootY)
-        {
-            parent[rootX] = rootY; 
+    void swim(int index) {
+        int v = heap[index];
+        while (index > 0) {
+            int parent = (index - 1) / 2;
+            if (!less(v, heap[parent])) {
+                break;
+            }
+            place(index, heap[parent]);
+            index = parent;
         }
+        place(index, v);
+    }
+
+    void sink(int index) {
+        int v = heap[index];
+        int n = static_cast<int>(heap.size());
+        while (true) {
+            int child = 2 * index + 1;
+            if (child >= n) {
+                break;
+            }
+            if (child + 1 < n && less(heap[child + 1], heap[child])) {
+                child++;
+            }
+            if (!less(heap[child], v)) {
+                break;
+            }
+            place(index, heap[child]);
+            index = child;
+        }
+        place(index, v);
+    }
+
+public:
+    IndexedMinHeap(int n) : pos(n, -1), key(n, INF) {
+        heap.reserve(n);
+    }
+
+    bool empty() const {
+        return heap.empty();
+    }
+
+    bool contains(int v) const {
+        return pos[v] >= 0;
+    }
+
+    /**
+     * Inserts v with key k, or lowers v's key to k if it is already queued.
+     * @return true if the heap changed.
+     */
+    bool pushOrDecrease(int v, int k) {
+        if (pos[v] < 0) {
+            key[v] = k;
+            heap.push_back(v);
+            swim(static_cast<int>(heap.size()) - 1);
+            return true;
+        }
+        if (k >= key[v]) {
+            return false;
+        }
+        key[v] = k;
+        swim(pos[v]);
+        return true;
+    }
+
+    int popMin() {
+        int top = heap[0];
+        int last = heap.back();
+        heap.pop_back();
+        pos[top] = -1;
+        if (!heap.empty()) {
+            place(0, last);
+            sink(0);
+        }
+        return top;
     }
 };
 
+/**
+ * LSD radix sort of edge indices 0..m-1 by 32-bit integer weight.
+ * Sorts (key, index) pairs in three 11-bit passes instead of moving Edge
+ * structs; digits on which every key agrees are skipped. Each pass builds
+ * per-thread histograms over fixed chunks, then every thread scatters its
+ * own chunk, which keeps the sort stable: equal weights stay in index order.
+ * @param m Number of edges.
+ * @param weightOf weightOf(e) returns the weight of edge e.
+ * @param numThreads Worker count (0 = all hardware threads).
+ * @return Edge indices ordered by (weight, index).
+ */
+template <typename WeightOf>
+std::vector<int> radixSortEdgeOrder(size_t m, WeightOf weightOf, unsigned numThreads = 0) {
+    const int DIGIT_BITS = 11;
+    const int BUCKETS = 1 << DIGIT_BITS;
+    const int PASSES = 3; // 3 x 11 bits covers 32-bit keys
+
+    std::vector<uint32_t> keys(m), keysTmp(m);
+    std::vector<int> order(m), orderTmp(m);
+    unsigned threads = parallelForThreads(m, numThreads);
+
+    // Flip the sign bit so negative weights sort before positive ones.
+    parallelFor(m, threads, [&](size_t begin, size_t end, unsigned) {
+        for (size_t e = begin; e < end; e++) {
+            keys[e] = static_cast<uint32_t>(weightOf(e)) ^ 0x80000000u;
+            order[e] = static_cast<int>(e);
+        }
+    });
+
+    // Global digit counts don't depend on order; use them to skip passes.
+    std::vector<std::vector<size_t>> counts(threads, std::vector<size_t>(PASSES * BUCKETS, 0));
+    parallelFor(m, threads, [&](size_t begin, size_t end, unsigned t) {
+        size_t* local = counts[t].data();
+        for (size_t e = begin; e < end; e++) {
+            uint32_t key = keys[e];
+            for (int pass = 0; pass < PASSES; pass++) {
+                local[pass * BUCKETS + ((key >> (pass * DIGIT_BITS)) & (BUCKETS - 1))]++;
+            }
+        }
+    });
+
+    std::vector<std::vector<size_t>> offsets(threads, std::vector<size_t>(BUCKETS));
+    for (int pass = 0; pass < PASSES; pass++) {
+        const int shift = pass * DIGIT_BITS;
+
+        bool trivial = false;
+        for (int b = 0; b < BUCKETS && !trivial; b++) {
+            size_t total = 0;
+            for (unsigned t = 0; t < threads; t++) {
+                total += counts[t][pass * BUCKETS + b];
+            }
+            trivial = (total == m);
+        }
+        if (trivial) {
+            continue;
+        }
+
+        // Per-thread histograms of this digit over the current order.
+        parallelFor(m, threads, [&](size_t begin, size_t end, unsigned t) {
+            size_t* local = offsets[t].data();
+            std::fill(local, local + BUCKETS, 0);
+            for (size_t k = begin; k < end; k++) {
+                local[(keys[k] >> shift) & (BUCKETS - 1)]++;
+            }
+        });
+
+        // Bucket-major, thread-minor exclusive prefix sum.
+        size_t running = 0;
+        for (int b = 0; b < BUCKETS; b++) {
+            for (unsigned t = 0; t < threads; t++) {
+                size_t count = offsets[t][b];
+                offsets[t][b] = running;
+                running += count;
+            }
+        }
+
+        parallelFor(m, threads, [&](size_t begin, size_t end, unsigned t) {
+            size_t* next = offsets[t].data();
+            for (size_t k = begin; k < end; k++) {
+                size_t slot = next[(keys[k] >> shift) & (BUCKETS - 1)]++;
+                keysTmp[slot] = keys[k];
+                orderTmp[slot] = order[k];
+            }
+        });
+
+        keys.swap(keysTmp);
+        order.swap(orderTmp);
+    }
+
+    return order;
+}
+
 //-------------------- MST ALGORITHMS CLASS --------------------
 
 class MSTAlgorithms {
 public:
     /**
      * Implements Prim's Algorithm to find the MST.
+     * On a disconnected graph Prim's is restarted from the lowest unvisited
+     * vertex, producing a minimum spanning forest.
      * @param graph The graph (using its adjacency list).
-     * @return The total weight of the Minimum Spanning Tree.
+     * @param mstEdges If non-null, receives the indices into `graph.edges` of the chosen edges.
+     * @param componentLabels If non-null, receives a component id (0, 1, ...) per vertex,
+     *                        numbered in order of each component's lowest vertex.
+     * @return The total weight of the Minimum Spanning Tree (forest, if disconnected).
      */
-    static int primsAlgorithm(Graph& graph) {
-        int mstWeight = 0;
-        int startNode = 0; // Start Prim's from node 0
+    static long long primsAlgorithm(Graph& graph, std::vector<int>* mstEdges = nullptr,
+                                    std::vector<int>* componentLabels = nullptr) {
+        long long mstWeight = 0;
 
         // TODO: Implement Prim's Algorithm.
         //
-        // 1. Create a min-priority queue to store {weight, vertex}.
+        // 1. Create a min-priority queue to store {weight, vertex, edge index}.
         //    (Hint: `std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>> pq;`)
                 
-                std::priority_queue<std::pair<int, int>,
-                                    std::vector<std::pair<int, int>>,
-                                    std::greater<std::pair<int, int>>> pq;
+                using Entry = std::tuple<int, int, int>; // {weight, vertex, edge index (-1 for a root)}
+                std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
 
         // 2. Create a `visited` vector (boolean) to track visited vertices.
         
                 std::vector<bool> visited(graph.V, false);
 
+                if (mstEdges)
+                {
+                    mstEdges->clear();
+                }
+                if (componentLabels)
+                {
+                    componentLabels->assign(graph.V, -1);
+                }
+                int componentId = 0;
+
         // 3. Push the starting node into the pq with weight 0: `pq.push({0, startNode});`
-        
-                pq.push({0, startNode});
+        //    Every still-unvisited vertex starts a new tree of the forest.
+
+                for (int startNode = 0; startNode < graph.V; startNode++)
+                {
+                    if (visited[startNode])
+                    {
+                        continue;
+                    }
+
+                    pq.push({0, startNode, -1});
 
         // 4. Loop while the priority queue is not empty:
         //    a. Get the top element (lightest edge): {weight, u}. Pop it.
@@ -140,26 +647,39 @@ public:
         //
         // 5. Return `mstWeight`.
 
-                while (!pq.empty())
-                {
-                    auto [weight, u] = pq.top();
-                    pq.pop();
-
-                    if (visited[u])
+                    while (!pq.empty())
                     {
-                        continue;
-                    }
+                        auto [weight, u, edgeIndex] = pq.top();
+                        pq.pop();
 
-                    visited[u] = true;
-                    mstWeight += weight;
+                        if (visited[u])
+                        {
+                            continue;
+                        }
 
-                    for (auto [v, w] : graph.adj[u])
-                    {
-                        if (!visited[v])
+                        visited[u] = true;
+                        mstWeight += weight;
+
+                        if (componentLabels)
+                        {
+                            (*componentLabels)[u] = componentId;
+                        }
+                        if (mstEdges && edgeIndex >= 0)
+                        {
+                            mstEdges->push_back(edgeIndex);
+                        }
+
+                        for (size_t k = 0; k < graph.adj[u].size(); k++)
                         {
-                            pq.push({w, v});
+                            auto [v, w] = graph.adj[u][k];
+                            if (!visited[v])
+                            {
+                                pq.push({w, v, graph.adjEdge[u][k]});
+                            }
                         }
                     }
+
+                    componentId++;
                 }
 
         return mstWeight; 
@@ -167,31 +687,38 @@ public:
 
     /**
      * Implements Kruskal's Algorithm to find the MST.
+     * A disconnected graph yields a minimum spanning forest.
      * @param graph The graph (using its edge list).
-     * @return The total weight of the Minimum Spanning Tree.
+     * @param mstEdges If non-null, receives the indices into `graph.edges` of the chosen edges.
+     * @param componentLabels If non-null, receives a component id (0, 1, ...) per vertex,
+     *                        numbered in order of each component's lowest vertex.
+     * @return The total weight of the Minimum Spanning Tree (forest, if disconnected).
      */
-    static int kruskalsAlgorithm(Graph& graph) {
-        int mstWeight = 0;
+    static long long kruskalsAlgorithm(Graph& graph, std::vector<int>* mstEdges = nullptr,
+                                       std::vector<int>* componentLabels = nullptr) {
+        long long mstWeight = 0;
 
         // TODO: Implement Kruskal's Algorithm.
         //
         // 1. Sort the graph's `edges` list in ascending order of weight.
         //    (Hint: Use `std::sort` with a custom lambda comparator).
+        //    Sorting edge indices instead of Edge copies also gives us the
+        //    indices to report in `mstEdges`.
 
-                std::vector<Edge> sortedEdges = graph.edges;
+                std::vector<int> sortedEdges(graph.edges.size());
+                for (size_t e = 0; e < sortedEdges.size(); e++)
+                {
+                    sortedEdges[e] = static_cast<int>(e);
+                }
                 std::sort(sortedEdges.begin(), sortedEdges.end(),
-                            [](const Edge& a, const Edge& b) {
-                                return a.weight < b.weight;
+                            [&graph](int a, int b) {
+                                const int wa = graph.edges[a].weight;
+                                const int wb = graph.edges[b].weight;
+                                return wa < wb || (wa == wb && a < b);
                                 });
 
         // 2. Create a DSU (Disjoint Set Union) structure with `graph.V` elements.
-                
-                DSU dsu(graph.V);
-
         // 3. Initialize an edge counter `edgeCount = 0`.
-        
-                int edgeCount = 0;
-
         // 4. Iterate through the sorted `edges`:
         //    a. Get the current edge (u, v, w).
         //    b. Find the set of u (call it rootU) and the set of v (call it rootV) using `dsu.find()`.
@@ -204,30 +731,1116 @@ public:
         // 5. (Optional but good) If `edgeCount` equals `graph.V - 1`, break early.
         //
         // 6. Return `mstWeight`.
+        //
+        // Steps 2-6 are shared with the other Kruskal variants (kruskalOverOrder).
 
-                for (const auto& edge : sortedEdges)
-                {
-                    int u = edge.src;
-                    int v = edge.dest;
-                    int w = edge.weight;
+                const Edge* edges = graph.edges.data();
+                mstWeight = kruskalOverOrder(graph.V, sortedEdges,
+                                             [edges](int e) { return std::make_pair(edges[e].src, edges[e].dest); },
+                                             [edges](int e) { return edges[e].weight; },
+                                             mstEdges, componentLabels);
 
-                    int rootU = dsu.find(u);
-                    int rootV = dsu.find(v);
+        return mstWeight; 
+    }
 
-                    if (rootU != rootV)
-                    {
-                        mstWeight += w;
-                        dsu.unite(rootU,rootV);
-                        edgeCount++;
+    /**
+     * Implements a parallel Boruvka's Algorithm to find the MST.
+     * Each round, every component picks its lightest outgoing edge (found by
+     * scanning the surviving edges in parallel with an atomic min per
+     * component), those edges are contracted through the DSU, and edges that
+     * became internal are dropped. Ties are broken by edge index, so the
+     * result matches Kruskal's with a stable sort.
+     * @param graph The graph (using its edge list).
+     * @param mstEdges If non-null, receives the indices into `graph.edges` of the chosen edges.
+     * @param numThreads Worker count (0 = all hardware threads).
+     * @return The total weight of the Minimum Spanning Tree (forest, if disconnected).
+     */
+    static long long boruvkaAlgorithm(const Graph& graph, std::vector<int>* mstEdges = nullptr,
+                                      unsigned numThreads = 0) {
+        if (graph.edges.size() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+            throw std::length_error("Boruvka's algorithm supports at most INT_MAX edges.");
+        }
 
-                        if (edgeCount == graph.V - 1)
-                        {
-                            break;
+        const uint64_t NONE = std::numeric_limits<uint64_t>::max();
+        long long mstWeight = 0;
+        DSU dsu(graph.V);
+        std::vector<int> label(graph.V);
+        std::vector<std::atomic<uint64_t>> cheapest(graph.V);
+
+        if (mstEdges) {
+            mstEdges->clear();
+        }
+
+        // Edges still able to join two components. Self-loops never can.
+        std::vector<int> live;
+        live.reserve(graph.edges.size());
+        for (size_t e = 0; e < graph.edges.size(); e++) {
+            if (graph.edges[e].src != graph.edges[e].dest) {
+                live.push_back(static_cast<int>(e));
+            }
+        }
+
+        unsigned threads = numThreads ? numThreads : std::max(1u, std::thread::hardware_concurrency());
+        std::vector<std::vector<int>> kept(threads);
+
+        while (!live.empty()) {
+            for (int v = 0; v < graph.V; v++) {
+                label[v] = dsu.find(v);
+            }
+            parallelFor(cheapest.size(), threads, [&](size_t begin, size_t end, unsigned) {
+                for (size_t v = begin; v < end; v++) {
+                    cheapest[v].store(NONE, std::memory_order_relaxed);
+                }
+            });
+
+            // Lightest outgoing edge per component; internal edges are filtered out.
+            parallelFor(live.size(), threads, [&](size_t begin, size_t end, unsigned t) {
+                std::vector<int>& out = kept[t];
+                for (size_t k = begin; k < end; k++) {
+                    int e = live[k];
+                    const Edge& edge = graph.edges[e];
+                    int cu = label[edge.src];
+                    int cv = label[edge.dest];
+                    if (cu == cv) {
+                        continue;
+                    }
+                    out.push_back(e);
+
+                    // Flip the sign bit so negative weights order correctly as unsigned.
+                    uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(edge.weight) ^ 0x80000000u) << 32)
+                                   | static_cast<uint32_t>(e);
+                    for (int c : {cu, cv}) {
+                        uint64_t current = cheapest[c].load(std::memory_order_relaxed);
+                        while (key < current &&
+                               !cheapest[c].compare_exchange_weak(current, key, std::memory_order_relaxed)) {
                         }
                     }
                 }
+            });
 
-        return mstWeight; 
+            // Empty every buffer once gathered: when `live` shrinks, parallelFor
+            // runs fewer chunks and the spare buffers must not carry old edges.
+            live.clear();
+            for (auto& part : kept) {
+                live.insert(live.end(), part.begin(), part.end());
+                part.clear();
+            }
+
+            bool merged = false;
+            for (int v = 0; v < graph.V; v++) {
+                uint64_t key = cheapest[v].load(std::memory_order_relaxed);
+                if (label[v] != v || key == NONE) {
+                    continue;
+                }
+                int e = static_cast<int>(key & 0xFFFFFFFFu);
+                const Edge& edge = graph.edges[e];
+                if (dsu.unite(edge.src, edge.dest)) {
+                    mstWeight += edge.weight;
+                    merged = true;
+                    if (mstEdges) {
+                        mstEdges->push_back(e);
+                    }
+                }
+            }
+
+            if (!merged) {
+                break;
+            }
+        }
+
+        return mstWeight;
+    }
+
+    /**
+     * Implements Filter-Kruskal to find the MST.
+     * Works on an array of edge indices (not copies of Edge). Large ranges are
+     * partitioned around a pivot weight; the light part is solved first, then
+     * heavy edges whose endpoints are already connected are discarded before
+     * the heavy part is processed, so most heavy edges are never sorted.
+     * Stops as soon as V - 1 edges have been accepted.
+     * @param graph The graph (using its edge list).
+     * @param mstEdges If non-null, receives the indices into `graph.edges` of the chosen edges.
+     * @return The total weight of the Minimum Spanning Tree (forest, if disconnected).
+     */
+    static long long filterKruskalAlgorithm(const Graph& graph, std::vector<int>* mstEdges = nullptr) {
+        std::vector<int> order;
+        order.reserve(graph.edges.size());
+        for (size_t e = 0; e < graph.edges.size(); e++) {
+            if (graph.edges[e].src != graph.edges[e].dest) {
+                order.push_back(static_cast<int>(e));
+            }
+        }
+
+        if (mstEdges) {
+            mstEdges->clear();
+        }
+
+        DSU dsu(graph.V);
+        KruskalState state{0, 0, mstEdges};
+        filterKruskalRange(graph, order.data(), order.data() + order.size(), dsu, state);
+        return state.mstWeight;
+    }
+
+    /**
+     * Prim's Algorithm with an indexed decrease-key heap.
+     * The heap never holds more than V entries, so dense graphs no longer
+     * pay O(E log E) for stale queue entries. Produces a forest on
+     * disconnected inputs, like primsAlgorithm.
+     * @param graph The graph (using its adjacency list).
+     * @param mstEdges If non-null, receives the indices into `graph.edges` of the chosen edges.
+     * @param componentLabels If non-null, receives a component id (0, 1, ...) per vertex.
+     * @return The total weight of the Minimum Spanning Tree (forest, if disconnected).
+     */
+    static long long primsIndexedHeap(const Graph& graph, std::vector<int>* mstEdges = nullptr,
+                                      std::vector<int>* componentLabels = nullptr) {
+        return primsHeapCore(
+            graph.V, [&graph](int e) { return graph.edges[e].weight; },
+            [&graph](int u, auto visit) {
+                for (size_t k = 0; k < graph.adj[u].size(); k++) {
+                    visit(graph.adj[u][k].first, graph.adj[u][k].second, graph.adjEdge[u][k]);
+                }
+            },
+            mstEdges, componentLabels);
+    }
+
+    /**
+     * Array-based O(V^2) Prim's over a flat, row-major V x V weight matrix
+     * (INF = no edge). No heap at all: each step scans one row, which beats
+     * any heap on complete or near-complete graphs.
+     * @param weights Row-major V x V matrix; weights[u * V + v] is the weight of (u, v).
+     * @param parent If non-null, receives each vertex's MST parent (-1 for tree roots).
+     * @return The total weight of the Minimum Spanning Tree (forest, if disconnected).
+     */
+    static long long primsDenseMatrix(const std::vector<int>& weights, int V, std::vector<int>* parent = nullptr) {
+        if (weights.size() != static_cast<size_t>(V) * V) {
+            throw std::invalid_argument("Weight matrix must have V * V entries.");
+        }
+        return primsDenseCore(V, weights.data(), nullptr, parent, nullptr, nullptr);
+    }
+
+    /**
+     * Prim's Algorithm that picks its implementation from the graph density:
+     * the O(V^2) array version when at least half of all vertex pairs are
+     * connected and its V x V matrices fit in DENSE_PRIM_MAX_MATRIX_BYTES
+     * (one matrix, or two when mstEdges is requested or some edge weighs
+     * INF), otherwise the indexed-heap version. Both give the same weight.
+     * @param graph The graph.
+     * @param mstEdges If non-null, receives the indices into `graph.edges` of the chosen edges.
+     * @param componentLabels If non-null, receives a component id (0, 1, ...) per vertex.
+     * @return The total weight of the Minimum Spanning Tree (forest, if disconnected).
+     */
+    static long long primsAuto(const Graph& graph, std::vector<int>* mstEdges = nullptr,
+                               std::vector<int>* componentLabels = nullptr) {
+        const long long V = graph.V;
+        const long long pairs = V * (V - 1) / 2;
+        // INF marks absent pairs in the weight matrix, so an edge of weight
+        // INF is only told apart by its entry in the edge-id matrix. That
+        // matrix is otherwise only needed to report which edges were chosen.
+        bool needEdgeIds = mstEdges != nullptr;
+        for (size_t e = 0; e < graph.edges.size() && !needEdgeIds; e++) {
+            needEdgeIds = graph.edges[e].weight == INF;
+        }
+        const size_t matrices = needEdgeIds ? 2 : 1;
+        bool dense = V >= 2 && V <= DENSE_PRIM_MAX_VERTICES &&
+                     static_cast<size_t>(V) * V * sizeof(int) * matrices <= DENSE_PRIM_MAX_MATRIX_BYTES &&
+                     static_cast<long long>(graph.edges.size()) * 2 >= pairs;
+
+        if (!dense) {
+            return primsIndexedHeap(graph, mstEdges, componentLabels);
+        }
+
+        // Keep the lightest of any parallel edges (lowest index on ties).
+        std::vector<int> weights(static_cast<size_t>(V) * V, INF);
+        std::vector<int> edgeIds;
+        if (needEdgeIds) {
+            edgeIds.assign(static_cast<size_t>(V) * V, -1);
+        }
+        for (size_t e = 0; e < graph.edges.size(); e++) {
+            const Edge& edge = graph.edges[e];
+            size_t forward = static_cast<size_t>(edge.src) * V + edge.dest;
+            size_t backward = static_cast<size_t>(edge.dest) * V + edge.src;
+            if (needEdgeIds) {
+                if (edgeIds[forward] < 0 || edge.weight < weights[forward]) {
+                    weights[forward] = weights[backward] = edge.weight;
+                    edgeIds[forward] = edgeIds[backward] = static_cast<int>(e);
+                }
+            } else if (edge.weight < weights[forward]) {
+                weights[forward] = weights[backward] = edge.weight;
+            }
+        }
+
+        return primsDenseCore(graph.V, weights.data(), needEdgeIds ? edgeIds.data() : nullptr, nullptr, mstEdges,
+                              componentLabels);
+    }
+
+    /**
+     * Prim's Algorithm on a CompactGraph, using its CSR index (built here if
+     * missing) and the indexed decrease-key heap.
+     * @param graph The graph.
+     * @param mstEdges If non-null, receives the indices of the chosen edges.
+     * @param componentLabels If non-null, receives a component id (0, 1, ...) per vertex.
+     * @return The total weight of the Minimum Spanning Tree (forest, if disconnected).
+     */
+    static long long primsAlgorithm(CompactGraph& graph, std::vector<int>* mstEdges = nullptr,
+                                    std::vector<int>* componentLabels = nullptr) {
+        if (!graph.hasAdjacency()) {
+            graph.buildAdjacency();
+        }
+
+        return primsHeapCore(
+            graph.V, [&graph](int e) { return graph.weight[e]; },
+            [&graph](int u, auto visit) {
+                for (size_t a = graph.adjOffset[u]; a < graph.adjOffset[u + 1]; a++) {
+                    int e = graph.adjEdgeId[a];
+                    visit(graph.neighbour(u, e), graph.weight[e], e);
+                }
+            },
+            mstEdges, componentLabels);
+    }
+
+    /**
+     * Kruskal's Algorithm on a CompactGraph. Sorts a permutation of edge
+     * indices by (weight, index); the columns themselves are never moved.
+     * @param graph The graph.
+     * @param mstEdges If non-null, receives the indices of the chosen edges.
+     * @param componentLabels If non-null, receives a component id (0, 1, ...) per vertex.
+     * @return The total weight of the Minimum Spanning Tree (forest, if disconnected).
+     */
+    static long long kruskalsAlgorithm(const CompactGraph& graph, std::vector<int>* mstEdges = nullptr,
+                                       std::vector<int>* componentLabels = nullptr) {
+        std::vector<int> order(graph.numEdges());
+        for (size_t e = 0; e < order.size(); e++) {
+            order[e] = static_cast<int>(e);
+        }
+        const int* w = graph.weight.data();
+        std::sort(order.begin(), order.end(), [w](int a, int b) {
+            return w[a] < w[b] || (w[a] == w[b] && a < b);
+        });
+
+        return kruskalOverOrder(graph.V, order,
+                                [&graph](int e) { return std::make_pair(graph.src[e], graph.dst[e]); },
+                                [w](int e) { return w[e]; },
+                                mstEdges, componentLabels);
+    }
+
+    /**
+     * Kruskal's Algorithm with the edge order produced by a parallel LSD
+     * radix sort (radixSortEdgeOrder) instead of a comparison sort.
+     * Same result as kruskalsAlgorithm, ties included.
+     * @param graph The graph (using its edge list).
+     * @param mstEdges If non-null, receives the indices into `graph.edges` of the chosen edges.
+     * @param componentLabels If non-null, receives a component id (0, 1, ...) per vertex.
+     * @param numThreads Worker count for the sort (0 = all hardware threads).
+     * @return The total weight of the Minimum Spanning Tree (forest, if disconnected).
+     */
+    static long long kruskalsRadix(const Graph& graph, std::vector<int>* mstEdges = nullptr,
+                                   std::vector<int>* componentLabels = nullptr, unsigned numThreads = 0) {
+        const Edge* edges = graph.edges.data();
+        std::vector<int> order = radixSortEdgeOrder(graph.edges.size(),
+                                                    [edges](size_t e) { return edges[e].weight; }, numThreads);
+
+        return kruskalOverOrder(graph.V, order,
+                                [edges](int e) { return std::make_pair(edges[e].src, edges[e].dest); },
+                                [edges](int e) { return edges[e].weight; },
+                                mstEdges, componentLabels);
+    }
+
+    // CompactGraph version of kruskalsRadix; reads the weight column directly.
+    static long long kruskalsRadix(const CompactGraph& graph, std::vector<int>* mstEdges = nullptr,
+                                   std::vector<int>* componentLabels = nullptr, unsigned numThreads = 0) {
+        const int* w = graph.weight.data();
+        std::vector<int> order = radixSortEdgeOrder(graph.numEdges(), [w](size_t e) { return w[e]; }, numThreads);
+        return kruskalOverOrder(graph.V, order,
+                                [&graph](int e) { return std::make_pair(graph.src[e], graph.dst[e]); },
+                                [w](int e) { return w[e]; },
+                                mstEdges, componentLabels);
+    }
+
+private:
+    struct KruskalState {
+        long long mstWeight;
+        int edgeCount;
+        std::vector<int>* mstEdges;
+    };
+
+    /**
+     * The Kruskal accept loop shared by every variant: takes the edges in
+     * [first, last) in order, keeping each one that joins two components,
+     * until V - 1 edges are in. endpointsOf(e) gives the pair (u, v) of edge
+     * e and weightOf(e) its weight. Can be called repeatedly on one DSU and
+     * state, as Filter-Kruskal does.
+     */
+    template <typename EndpointsOf, typename WeightOf>
+    static void kruskalAccept(int V, const int* first, const int* last, EndpointsOf endpointsOf, WeightOf weightOf,
+                              DSU& dsu, KruskalState& state) {
+        for (const int* it = first; it != last && state.edgeCount < V - 1; ++it) {
+            std::pair<int, int> ends = endpointsOf(*it);
+            if (dsu.unite(ends.first, ends.second)) {
+                state.mstWeight += weightOf(*it);
+                state.edgeCount++;
+                if (state.mstEdges) {
+                    state.mstEdges->push_back(*it);
+                }
+            }
+        }
+    }
+
+    // Kruskal's Algorithm over edges already in the order to try them.
+    template <typename EndpointsOf, typename WeightOf>
+    static long long kruskalOverOrder(int V, const std::vector<int>& order, EndpointsOf endpointsOf,
+                                      WeightOf weightOf, std::vector<int>* mstEdges,
+                                      std::vector<int>* componentLabels) {
+        DSU dsu(V);
+        KruskalState state{0, 0, mstEdges};
+
+        if (mstEdges) {
+            mstEdges->clear();
+        }
+
+        kruskalAccept(V, order.data(), order.data() + order.size(), endpointsOf, weightOf, dsu, state);
+
+        if (componentLabels) {
+            labelComponents(dsu, V, *componentLabels);
+        }
+        return state.mstWeight;
+    }
+
+    /**
+     * Indexed-heap Prim's shared by the Graph and CompactGraph front ends.
+     * weightOf(e) gives the weight of edge e; forEachNeighbour(u, visit)
+     * calls visit(v, w, e) for every edge e = (u, v) of weight w.
+     */
+    template <typename WeightOf, typename ForEachNeighbour>
+    static long long primsHeapCore(int V, WeightOf weightOf, ForEachNeighbour forEachNeighbour,
+                                   std::vector<int>* mstEdges, std::vector<int>* componentLabels) {
+        long long mstWeight = 0;
+        IndexedMinHeap heap(V);
+        std::vector<int> bestEdge(V, -1);
+        std::vector<bool> inTree(V, false);
+
+        if (mstEdges) {
+            mstEdges->clear();
+        }
+        if (componentLabels) {
+            componentLabels->assign(V, -1);
+        }
+
+        int componentId = 0;
+        for (int startNode = 0; startNode < V; startNode++) {
+            if (inTree[startNode]) {
+                continue;
+            }
+
+            heap.pushOrDecrease(startNode, 0);
+            while (!heap.empty()) {
+                int u = heap.popMin();
+                inTree[u] = true;
+
+                if (componentLabels) {
+                    (*componentLabels)[u] = componentId;
+                }
+                if (bestEdge[u] >= 0) {
+                    mstWeight += weightOf(bestEdge[u]);
+                    if (mstEdges) {
+                        mstEdges->push_back(bestEdge[u]);
+                    }
+                }
+
+                forEachNeighbour(u, [&](int v, int w, int e) {
+                    if (!inTree[v] && heap.pushOrDecrease(v, w)) {
+                        bestEdge[v] = e;
+                    }
+                });
+            }
+
+            componentId++;
+        }
+
+        return mstWeight;
+    }
+
+    // primsAuto only builds V x V matrices up to this many vertices, and only
+    // while they fit in this many bytes altogether.
+    static constexpr int DENSE_PRIM_MAX_VERTICES = 16384;
+    static constexpr size_t DENSE_PRIM_MAX_MATRIX_BYTES = size_t(256) << 20;
+
+    // With edgeIds, a pair (u, v) is an edge iff edgeIds[u * V + v] >= 0 and
+    // weights may hold INF; without it, INF in weights means "no edge".
+    // A vertex is reached once from[v] >= 0, so dist never needs a sentinel.
+    static long long primsDenseCore(int V, const int* weights, const int* edgeIds, std::vector<int>* parent,
+                                    std::vector<int>* mstEdges, std::vector<int>* componentLabels) {
+        long long mstWeight = 0;
+        std::vector<int> dist(V, INF);
+        std::vector<int> from(V, -1);
+        std::vector<char> inTree(V, 0);
+
+        if (parent) {
+            parent->assign(V, -1);
+        }
+        if (mstEdges) {
+            mstEdges->clear();
+        }
+        if (componentLabels) {
+            componentLabels->assign(V, -1);
+        }
+
+        int componentId = -1;
+        int nextStart = 0;
+        for (int step = 0; step < V; step++) {
+            int u = -1;
+            int best = INF;
+            for (int v = 0; v < V; v++) {
+                if (!inTree[v] && from[v] >= 0 && (u < 0 || dist[v] < best)) {
+                    best = dist[v];
+                    u = v;
+                }
+            }
+
+            if (u < 0) {
+                // Nothing reachable is left: start the next tree of the forest.
+                while (inTree[nextStart]) {
+                    nextStart++;
+                }
+                u = nextStart;
+                componentId++;
+            } else {
+                mstWeight += best;
+                if (parent) {
+                    (*parent)[u] = from[u];
+                }
+                if (mstEdges) {
+                    mstEdges->push_back(edgeIds[static_cast<size_t>(from[u]) * V + u]);
+                }
+            }
+
+            inTree[u] = 1;
+            if (componentLabels) {
+                (*componentLabels)[u] = componentId;
+            }
+
+            const int* row = weights + static_cast<size_t>(u) * V;
+            const int* rowIds = edgeIds ? edgeIds + static_cast<size_t>(u) * V : nullptr;
+            for (int v = 0; v < V; v++) {
+                bool isEdge = rowIds ? rowIds[v] >= 0 : row[v] != INF;
+                if (!inTree[v] && isEdge && (from[v] < 0 || row[v] < dist[v])) {
+                    dist[v] = row[v];
+                    from[v] = u;
+                }
+            }
+        }
+
+        return mstWeight;
+    }
+
+    // Numbers the DSU's sets 0, 1, ... in order of their lowest vertex.
+    static void labelComponents(DSU& dsu, int V, std::vector<int>& labels) {
+        std::vector<int> idOfRoot(V, -1);
+        labels.assign(V, -1);
+        int nextId = 0;
+        for (int v = 0; v < V; v++) {
+            int root = dsu.find(v);
+            if (idOfRoot[root] < 0) {
+                idOfRoot[root] = nextId++;
+            }
+            labels[v] = idOfRoot[root];
+        }
+    }
+
+    // Below this many edges Filter-Kruskal just sorts and scans.
+    static const size_t FILTER_KRUSKAL_BASE_CASE = 1024;
+
+    static void kruskalScan(const Graph& graph, int* first, int* last, DSU& dsu, KruskalState& state) {
+        std::sort(first, last, [&](int a, int b) {
+            const int wa = graph.edges[a].weight;
+            const int wb = graph.edges[b].weight;
+            return wa < wb || (wa == wb && a < b);
+        });
+
+        const Edge* edges = graph.edges.data();
+        kruskalAccept(graph.V, first, last,
+                      [edges](int e) { return std::make_pair(edges[e].src, edges[e].dest); },
+                      [edges](int e) { return edges[e].weight; }, dsu, state);
+    }
+
+    static void filterKruskalRange(const Graph& graph, int* first, int* last, DSU& dsu, KruskalState& state) {
+        if (first == last || state.edgeCount >= graph.V - 1) {
+            return;
+        }
+
+        size_t count = static_cast<size_t>(last - first);
+        if (count <= FILTER_KRUSKAL_BASE_CASE) {
+            kruskalScan(graph, first, last, dsu, state);
+            return;
+        }
+
+        // Median-of-three pivot weight.
+        int a = graph.edges[first[0]].weight;
+        int b = graph.edges[first[count / 2]].weight;
+        int c = graph.edges[last[-1]].weight;
+        int pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+        // Every edge of one weight lands on the same side, which keeps the
+        // (weight, index) order of a full sort.
+        int* middle = std::partition(first, last, [&](int e) { return graph.edges[e].weight < pivot; });
+        if (middle == first) {
+            middle = std::partition(first, last, [&](int e) { return graph.edges[e].weight <= pivot; });
+            if (middle == last) {
+                kruskalScan(graph, first, last, dsu, state); // All weights equal
+                return;
+            }
+        }
+
+        filterKruskalRange(graph, first, middle, dsu, state);
+
+        int* heavyEnd = std::remove_if(middle, last, [&](int e) {
+            return dsu.connected(graph.edges[e].src, graph.edges[e].dest);
+        });
+        filterKruskalRange(graph, middle, heavyEnd, dsu, state);
+    }
+};
+
+//-------------------- PARALLEL CONNECTIVITY --------------------
+
+class ConnectivityAlgorithms {
+public:
+    /**
+     * Connected components of `graph`, computed by uniting the endpoints of
+     * `graph.edges` from several threads through a ConcurrentDSU.
+     * @param numThreads Worker count (0 = all hardware threads).
+     * @param componentCount If non-null, receives the number of components.
+     * @return label[v] for every vertex: the smallest vertex id in v's component.
+     */
+    static std::vector<int> connectedComponents(const Graph& graph, unsigned numThreads = 0,
+                                                int* componentCount = nullptr) {
+        ConcurrentDSU dsu(graph.V);
+
+        parallelFor(graph.edges.size(), numThreads, [&](size_t begin, size_t end, unsigned) {
+            for (size_t e = begin; e < end; e++) {
+                dsu.unite(graph.edges[e].src, graph.edges[e].dest);
+            }
+        });
+
+        std::vector<int> label(graph.V);
+        std::atomic<int> roots(0);
+        parallelFor(label.size(), numThreads, [&](size_t begin, size_t end, unsigned) {
+            int localRoots = 0;
+            for (size_t v = begin; v < end; v++) {
+                label[v] = dsu.find(static_cast<int>(v));
+                if (label[v] == static_cast<int>(v)) {
+                    localRoots++;
+                }
+            }
+            roots += localRoots;
+        });
+
+        if (componentCount) {
+            *componentCount = roots.load();
+        }
+        return label;
+    }
+};
+
+
+//-------------------- ONLINE MST --------------------
+
+/**
+ * Minimum spanning forest maintained under edge insertions.
+ * The forest is kept in a link-cut tree where every MST edge is its own node
+ * between its two endpoints, so "heaviest edge on the u-v path" is a path
+ * aggregate. Inserting (u, v, w):
+ *   - u, v in different trees: link them through the new edge.
+ *   - otherwise: if the heaviest edge on the u-v path is heavier than w,
+ *     cut it out and link the new edge in its place; else drop the new edge.
+ * Connectivity is answered by a DSU, since trees only ever merge.
+ * Each insertion is O(log V) amortized and totalWeight() is O(1).
+ */
+class OnlineMST {
+    int V;
+    long long mstWeight;
+    int edgeCount;
+    DSU components; // Insert-only, so trees only ever merge
+
+    // Link-cut tree nodes: 0..V-1 are vertices, V.. are edges.
+    std::vector<int> parent;
+    std::vector<std::array<int, 2>> child;
+    std::vector<char> reversed;
+    std::vector<int> maxNode; // Heaviest edge node in the splay subtree (-1 if none)
+    std::vector<Edge> edgeOf; // edgeOf[x - V] for edge node x
+    std::vector<int> freeNodes;
+    std::vector<int> splayStack;
+
+    bool isEdgeNode(int x) const {
+        return x >= V;
+    }
+
+    bool heavier(int a, int b) const {
+        if (a < 0) return false;
+        if (b < 0) return true;
+        return edgeOf[a - V].weight > edgeOf[b - V].weight;
+    }
+
+    bool isSplayRoot(int x) const {
+        int p = parent[x];
+        return p < 0 || (child[p][0] != x && child[p][1] != x);
+    }
+
+    void pull(int x) {
+        int best = isEdgeNode(x) ? x : -1;
+        for (int c : child[x]) {
+            if (c >= 0 && heavier(maxNode[c], best)) {
+                best = maxNode[c];
+            }
+        }
+        maxNode[x] = best;
+    }
+
+    void push(int x) {
+        if (!reversed[x]) {
+            return;
+        }
+        std::swap(child[x][0], child[x][1]);
+        for (int c : child[x]) {
+            if (c >= 0) {
+                reversed[c] ^= 1;
+            }
+        }
+        reversed[x] = 0;
+    }
+
+    void rotate(int x) {
+        int p = parent[x];
+        int g = parent[p];
+        int side = (child[p][1] == x) ? 1 : 0;
+
+        if (!isSplayRoot(p)) {
+            child[g][child[g][1] == p ? 1 : 0] = x;
+        }
+        parent[x] = g;
+
+        child[p][side] = child[x][side ^ 1];
+        if (child[p][side] >= 0) {
+            parent[child[p][side]] = p;
+        }
+        child[x][side ^ 1] = p;
+        parent[p] = x;
+
+        pull(p);
+        pull(x);
+    }
+
+    void splay(int x) {
+        // Apply pending reversals from the splay root down to x first.
+        splayStack.clear();
+        for (int y = x;; y = parent[y]) {
+            splayStack.push_back(y);
+            if (isSplayRoot(y)) {
+                break;
+            }
+        }
+        for (auto it = splayStack.rbegin(); it != splayStack.rend(); ++it) {
+            push(*it);
+        }
+
+        while (!isSplayRoot(x)) {
+            int p = parent[x];
+            if (!isSplayRoot(p)) {
+                int g = parent[p];
+                bool zigZig = (child[g][0] == p) == (child[p][0] == x);
+                rotate(zigZig ? p : x);
+            }
+            rotate(x);
+        }
+    }
+
+    void access(int x) {
+        for (int last = -1, y = x; y >= 0; last = y, y = parent[y]) {
+            splay(y);
+            child[y][1] = last;
+            pull(y);
+        }
+        splay(x);
+    }
+
+    void makeRoot(int x) {
+        access(x);
+        reversed[x] ^= 1;
+    }
+
+    void link(int x, int y) {
+        makeRoot(x);
+        parent[x] = y;
+    }
+
+    // Removes the tree edge between adjacent nodes x and y.
+    void cut(int x, int y) {
+        makeRoot(x);
+        access(y);
+        // x is now y's left child with nothing in between.
+        child[y][0] = -1;
+        parent[x] = -1;
+        pull(y);
+    }
+
+    int allocateEdgeNode(int u, int v, int w) {
+        int x;
+        if (!freeNodes.empty()) {
+            x = freeNodes.back();
+            freeNodes.pop_back();
+            edgeOf[x - V] = {u, v, w};
+        } else {
+            x = static_cast<int>(parent.size());
+            parent.push_back(-1);
+            child.push_back({-1, -1});
+            reversed.push_back(0);
+            maxNode.push_back(x);
+            edgeOf.push_back({u, v, w});
+        }
+        parent[x] = -1;
+        child[x] = {-1, -1};
+        reversed[x] = 0;
+        maxNode[x] = x;
+        return x;
+    }
+
+public:
+    OnlineMST(int vertices)
+        : V(vertices), mstWeight(0), edgeCount(0), components(vertices),
+          parent(vertices, -1), child(vertices, {-1, -1}), reversed(vertices, 0), maxNode(vertices, -1) {}
+
+    /**
+     * Adds an undirected edge and updates the minimum spanning forest.
+     * @return true if the edge is now part of the forest.
+     */
+    bool insertEdge(int u, int v, int w) {
+        if (u < 0 || u >= V || v < 0 || v >= V) {
+            throw std::out_of_range("Vertex index out of range in OnlineMST::insertEdge.");
+        }
+        if (u == v) {
+            return false;
+        }
+
+        if (components.unite(u, v)) {
+            int e = allocateEdgeNode(u, v, w);
+            link(u, e);
+            link(e, v);
+            mstWeight += w;
+            edgeCount++;
+            return true;
+        }
+
+        makeRoot(u);
+        access(v);
+        int heaviest = maxNode[v];
+        Edge old = edgeOf[heaviest - V];
+        if (old.weight <= w) {
+            return false;
+        }
+
+        cut(old.src, heaviest);
+        cut(heaviest, old.dest);
+        freeNodes.push_back(heaviest);
+        mstWeight -= old.weight;
+
+        int e = allocateEdgeNode(u, v, w);
+        link(u, e);
+        link(e, v);
+        mstWeight += w;
+        return true;
+    }
+
+    bool connected(int u, int v) {
+        return components.connected(u, v);
+    }
+
+    long long totalWeight() const {
+        return mstWeight;
+    }
+
+    int numEdges() const {
+        return edgeCount;
+    }
+
+    // The edges currently in the forest, in no particular order.
+    std::vector<Edge> currentEdges() const {
+        std::vector<char> isFree(edgeOf.size(), 0);
+        for (int x : freeNodes) {
+            isFree[x - V] = 1;
+        }
+        std::vector<Edge> result;
+        result.reserve(edgeCount);
+        for (size_t k = 0; k < edgeOf.size(); k++) {
+            if (!isFree[k]) {
+                result.push_back(edgeOf[k]);
+            }
+        }
+        return result;
+    }
+};
+
+//-------------------- EUCLIDEAN MST --------------------
+
+/**
+ * Euclidean MST of a 2-D or 3-D point set without building the complete
+ * graph. Runs Boruvka's rounds where each point's nearest neighbour in a
+ * different component is found with a k-d tree; subtrees whose points all
+ * belong to the querying component are skipped. Memory is O(n) and each
+ * round is roughly O(n log n), with O(log n) rounds.
+ * Ties between equal lengths are broken by point index, so the result is
+ * deterministic.
+ */
+template <int D>
+class EuclideanMST {
+public:
+    using Point = std::array<double, D>;
+
+    /**
+     * @param points The input points.
+     * @param mstEdges If non-null, receives the MST edges as (i, j) point-index pairs.
+     * @param numThreads Worker count for the nearest-neighbour queries (0 = all hardware threads).
+     * @return The total Euclidean length of the MST.
+     */
+    static double compute(const std::vector<Point>& points,
+                          std::vector<std::pair<int, int>>* mstEdges = nullptr,
+                          unsigned numThreads = 0) {
+        EuclideanMST solver(points);
+        return solver.run(mstEdges, numThreads);
+    }
+
+private:
+    static const int LEAF_SIZE = 16;
+
+    struct Node {
+        Point lo, hi;   // Bounding box
+        int begin, end; // Range in `order`
+        int left, right;
+        int component;  // Shared component of every point below, or -1
+    };
+
+    const std::vector<Point>& input;
+    std::vector<int> order;      // Tree position -> original point index
+    std::vector<Point> sorted;   // Points in tree order, for locality
+    std::vector<int> component;  // Per tree position
+    std::vector<Node> nodes;     // Pre-order: children after their parent
+
+    explicit EuclideanMST(const std::vector<Point>& points) : input(points) {}
+
+    static double distance2(const Point& a, const Point& b) {
+        double sum = 0;
+        for (int d = 0; d < D; d++) {
+            double diff = a[d] - b[d];
+            sum += diff * diff;
+        }
+        return sum;
+    }
+
+    static double boxDistance2(const Node& node, const Point& p) {
+        double sum = 0;
+        for (int d = 0; d < D; d++) {
+            double diff = 0;
+            if (p[d] < node.lo[d]) {
+                diff = node.lo[d] - p[d];
+            } else if (p[d] > node.hi[d]) {
+                diff = p[d] - node.hi[d];
+            }
+            sum += diff * diff;
+        }
+        return sum;
+    }
+
+    // Total order on candidate edges: length, then lower endpoint, then higher.
+    static bool better(double d2a, int a1, int a2, double d2b, int b1, int b2) {
+        if (d2a != d2b) {
+            return d2a < d2b;
+        }
+        if (std::min(a1, a2) != std::min(b1, b2)) {
+            return std::min(a1, a2) < std::min(b1, b2);
+        }
+        return std::max(a1, a2) < std::max(b1, b2);
+    }
+
+    int build(int begin, int end) {
+        int index = static_cast<int>(nodes.size());
+        nodes.push_back(Node());
+        Node node;
+        node.begin = begin;
+        node.end = end;
+        node.left = node.right = -1;
+        node.component = -1;
+        node.lo = node.hi = input[order[begin]];
+        for (int k = begin + 1; k < end; k++) {
+            const Point& p = input[order[k]];
+            for (int d = 0; d < D; d++) {
+                node.lo[d] = std::min(node.lo[d], p[d]);
+                node.hi[d] = std::max(node.hi[d], p[d]);
+            }
+        }
+
+        if (end - begin > LEAF_SIZE) {
+            int axis = 0;
+            for (int d = 1; d < D; d++) {
+                if (node.hi[d] - node.lo[d] > node.hi[axis] - node.lo[axis]) {
+                    axis = d;
+                }
+            }
+            int middle = begin + (end - begin) / 2;
+            std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end,
+                             [&](int a, int b) { return input[a][axis] < input[b][axis]; });
+            node.left = build(begin, middle);
+            node.right = build(middle, end);
+        }
+
+        nodes[index] = node;
+        return index;
+    }
+
+    // Recomputes each node's shared component bottom-up.
+    void labelNodes() {
+        for (int i = static_cast<int>(nodes.size()) - 1; i >= 0; i--) {
+            Node& node = nodes[i];
+            if (node.left < 0) {
+                int c = component[node.begin];
+                for (int k = node.begin + 1; k < node.end && c >= 0; k++) {
+                    if (component[k] != c) {
+                        c = -1;
+                    }
+                }
+                node.component = c;
+            } else {
+                int c = nodes[node.left].component;
+                node.component = (c == nodes[node.right].component) ? c : -1;
+            }
+        }
+    }
+
+    // Nearest point (by the `better` order) outside the component of tree
+    // position q, no farther than the incoming bestD2. bestPos stays -1 if
+    // nothing within that bound exists.
+    void nearestForeign(int q, std::vector<int>& stack, double& bestD2, int& bestPos) const {
+        const Point& p = sorted[q];
+        const int c = component[q];
+        const int self = order[q];
+
+        stack.clear();
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.back()];
+            stack.pop_back();
+
+            if (node.component == c || boxDistance2(node, p) > bestD2) {
+                continue;
+            }
+
+            if (node.left < 0) {
+                for (int k = node.begin; k < node.end; k++) {
+                    if (component[k] == c) {
+                        continue;
+                    }
+                    double d2 = distance2(p, sorted[k]);
+                    if (bestPos < 0 ? d2 <= bestD2 : better(d2, self, order[k], bestD2, self, order[bestPos])) {
+                        bestD2 = d2;
+                        bestPos = k;
+                    }
+                }
+                continue;
+            }
+
+            // Visit the nearer child first (pushed last).
+            double dl = boxDistance2(nodes[node.left], p);
+            double dr = boxDistance2(nodes[node.right], p);
+            if (dl < dr) {
+                stack.push_back(node.right);
+                stack.push_back(node.left);
+            } else {
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+            }
+        }
+    }
+
+    double run(std::vector<std::pair<int, int>>* mstEdges, unsigned numThreads) {
+        const int n = static_cast<int>(input.size());
+        if (mstEdges) {
+            mstEdges->clear();
+        }
+        if (n < 2) {
+            return 0.0;
+        }
+
+        order.resize(n);
+        for (int i = 0; i < n; i++) {
+            order[i] = i;
+        }
+        nodes.reserve(2 * (n / LEAF_SIZE + 1));
+        build(0, n);
+
+        sorted.resize(n);
+        for (int k = 0; k < n; k++) {
+            sorted[k] = input[order[k]];
+        }
+
+        DSU dsu(n);
+        component.resize(n);
+        std::vector<double> candD2(n);
+        std::vector<int> candPos(n);
+        std::vector<int> bestOf(n); // Per component root: tree position of its best candidate
+        // Per component root: shortest outgoing edge found so far this round.
+        // Seeding each query with it prunes most of the tree for large components.
+        std::vector<std::atomic<double>> bound(n);
+        double total = 0.0;
+
+        while (dsu.componentCount() > 1) {
+            for (int k = 0; k < n; k++) {
+                component[k] = dsu.find(order[k]);
+            }
+            labelNodes();
+            for (int i = 0; i < n; i++) {
+                bound[i].store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+            }
+
+            parallelFor(n, numThreads, [&](size_t begin, size_t end, unsigned) {
+                std::vector<int> stack;
+                for (size_t q = begin; q < end; q++) {
+                    std::atomic<double>& shared = bound[component[q]];
+                    candD2[q] = shared.load(std::memory_order_relaxed);
+                    candPos[q] = -1;
+                    nearestForeign(static_cast<int>(q), stack, candD2[q], candPos[q]);
+
+                    double current = shared.load(std::memory_order_relaxed);
+                    while (candPos[q] >= 0 && candD2[q] < current &&
+                           !shared.compare_exchange_weak(current, candD2[q], std::memory_order_relaxed)) {
+                    }
+                }
+            });
+
+            std::fill(bestOf.begin(), bestOf.end(), -1);
+            for (int q = 0; q < n; q++) {
+                if (candPos[q] < 0) {
+                    continue;
+                }
+                int& best = bestOf[component[q]];
+                if (best < 0 || better(candD2[q], order[q], order[candPos[q]],
+                                       candD2[best], order[best], order[candPos[best]])) {
+                    best = q;
+                }
+            }
+
+            for (int root = 0; root < n; root++) {
+                int q = bestOf[root];
+                if (q < 0) {
+                    continue;
+                }
+                int a = order[q];
+                int b = order[candPos[q]];
+                if (dsu.unite(a, b)) {
+                    total += std::sqrt(candD2[q]);
+                    if (mstEdges) {
+                        mstEdges->push_back({a, b});
+                    }
+                }
+            }
+        }
+
+        return total;
     }
 };
 
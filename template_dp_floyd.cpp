@@ -10,6 +10,22 @@
 #include <limits>   // Required for std::numeric_limits
 #include <algorithm>
 #include <iomanip>  // For std::setw
+#include <string>
+#include <fstream>  // For the binary distance-matrix writer
+#include <cstdint>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>  // For MapViewOfFile (DistanceMatrixReader)
+#else
+#include <fcntl.h>     // For open (DistanceMatrixReader)
+#include <sys/mman.h>  // For mmap (DistanceMatrixReader)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 // Constant for infinity, used to represent non-existent paths
 const int INF = std::numeric_limits<int>::max();
@@ -31,6 +47,11 @@ public:
         return numVertices;
     }
 
+    bool isDirected() const
+    {
+        return directed;
+    }
+
     // Pure virtual functions - to be implemented by derived classes
     virtual void addEdge(int source, int destination, int weight) = 0;
     virtual bool hasEdge(int source, int destination) const = 0;
@@ -143,6 +164,173 @@ public:
     }
 };
 
+//-------------------- FLAT DISTANCE MATRIX --------------------
+// Row-major n x n distance matrix kept in a single contiguous buffer.
+// Unlike vector<vector<int>>, a row is one pointer away and the whole
+// matrix is one allocation, which is what the binary writer below expects.
+class DistanceMatrix
+{
+private:
+    int numVertices;
+    std::vector<int> data;
+
+public:
+    DistanceMatrix(int vertices = 0) : numVertices(vertices), data(static_cast<size_t>(vertices) * vertices, INF) {}
+
+    int size() const
+    {
+        return numVertices;
+    }
+
+    void resize(int vertices, int value = INF)
+    {
+        numVertices = vertices;
+        data.assign(static_cast<size_t>(vertices) * vertices, value);
+    }
+
+    int* row(int i)
+    {
+        return data.data() + static_cast<size_t>(i) * numVertices;
+    }
+
+    const int* row(int i) const
+    {
+        return data.data() + static_cast<size_t>(i) * numVertices;
+    }
+
+    int& at(int i, int j)
+    {
+        return row(i)[j];
+    }
+
+    int at(int i, int j) const
+    {
+        return row(i)[j];
+    }
+};
+
+//-------------------- NEXT-HOP MATRIX --------------------
+// nextHop(i, j) is the vertex that follows i on a shortest i -> j path,
+// or NO_HOP if j is unreachable from i. Entries are int16 while V fits
+// (V < 32768), halving the footprint, and int32 otherwise.
+class NextHopMatrix
+{
+private:
+    int numVertices;
+    bool compact;
+    std::vector<int16_t> hops16;
+    std::vector<int32_t> hops32;
+
+public:
+    static constexpr int NO_HOP = -1;
+
+    NextHopMatrix(int vertices = 0) : numVertices(0), compact(true)
+    {
+        reset(vertices);
+    }
+
+    // Resizes to vertices x vertices with every entry set to NO_HOP.
+    void reset(int vertices)
+    {
+        numVertices = vertices;
+        compact = vertices < 32768;
+        size_t cells = static_cast<size_t>(vertices) * vertices;
+
+        if (compact)
+        {
+            hops16.assign(cells, static_cast<int16_t>(NO_HOP));
+            hops32.clear();
+            hops32.shrink_to_fit();
+        }
+        else
+        {
+            hops32.assign(cells, NO_HOP);
+            hops16.clear();
+            hops16.shrink_to_fit();
+        }
+    }
+
+    int size() const
+    {
+        return numVertices;
+    }
+
+    bool isCompact() const
+    {
+        return compact;
+    }
+
+    int get(int i, int j) const
+    {
+        size_t index = static_cast<size_t>(i) * numVertices + j;
+        return compact ? hops16[index] : hops32[index];
+    }
+
+    void set(int i, int j, int hop)
+    {
+        size_t index = static_cast<size_t>(i) * numVertices + j;
+        if (compact)
+        {
+            hops16[index] = static_cast<int16_t>(hop);
+        }
+        else
+        {
+            hops32[index] = hop;
+        }
+    }
+
+    // Raw row access for the relaxation kernel; HopType must match the
+    // active storage (int16_t when isCompact(), int32_t otherwise).
+    template <typename HopType>
+    HopType* rowAs(int i);
+
+    /**
+     * Returns the vertices of a shortest path from `source` to `destination`
+     * (both included) in O(path length), or an empty vector if there is no
+     * path. Also returns empty if the walk revisits a vertex, which only
+     * happens when the matrix came from a graph with a negative cycle.
+     */
+    std::vector<int> reconstructPath(int source, int destination) const
+    {
+        if (source < 0 || source >= numVertices || destination < 0 || destination >= numVertices)
+        {
+            throw std::out_of_range("Vertex index out of range in reconstructPath.");
+        }
+
+        std::vector<int> path;
+        if (get(source, destination) == NO_HOP)
+        {
+            return path;
+        }
+
+        path.push_back(source);
+        int current = source;
+        while (current != destination)
+        {
+            current = get(current, destination);
+            if (current == NO_HOP || static_cast<int>(path.size()) >= numVertices)
+            {
+                return std::vector<int>();
+            }
+            path.push_back(current);
+        }
+
+        return path;
+    }
+};
+
+template <>
+inline int16_t* NextHopMatrix::rowAs<int16_t>(int i)
+{
+    return hops16.data() + static_cast<size_t>(i) * numVertices;
+}
+
+template <>
+inline int32_t* NextHopMatrix::rowAs<int32_t>(int i)
+{
+    return hops32.data() + static_cast<size_t>(i) * numVertices;
+}
+
 //-------------------- GRAPH ALGORITHMS --------------------
 class GraphAlgorithms
 {
@@ -218,6 +406,702 @@ public:
 
         return true;
     }
+
+    /**
+     * Floyd-Warshall on a flat DistanceMatrix.
+     * Same contract as the vector<vector<int>> overload, but the matrix is
+     * initialized from getNeighbors (O(V^2 + E) instead of V^2 getWeight
+     * scans) and the inner loop walks two contiguous rows.
+     */
+    static bool floydWarshall(const Graph &graph, DistanceMatrix &distances)
+    {
+        initializeDistances(graph, distances, nullptr);
+        relaxAllPairs<int16_t>(distances, nullptr);
+        return !hasNegativeCycle(distances);
+    }
+
+    /**
+     * Floyd-Warshall that also records, for every pair (i, j), the first
+     * vertex after i on a shortest i -> j path. The next-hop matrix is
+     * updated inside the same relaxation loop, so routes cost one extra
+     * store per improvement rather than a second pass.
+     * Paths are only meaningful when this returns `true`.
+     */
+    static bool floydWarshall(const Graph &graph, DistanceMatrix &distances, NextHopMatrix &nextHop)
+    {
+        initializeDistances(graph, distances, &nextHop);
+
+        if (nextHop.isCompact())
+        {
+            relaxAllPairs<int16_t>(distances, &nextHop);
+        }
+        else
+        {
+            relaxAllPairs<int32_t>(distances, &nextHop);
+        }
+
+        return !hasNegativeCycle(distances);
+    }
+
+private:
+    static void initializeDistances(const Graph &graph, DistanceMatrix &distances, NextHopMatrix *nextHop)
+    {
+        int n = graph.getNumVertices();
+        distances.resize(n, INF);
+
+        if (nextHop)
+        {
+            nextHop->reset(n);
+        }
+
+        for (int i = 0; i < n; ++i)
+        {
+            int* rowI = distances.row(i);
+            rowI[i] = 0;
+
+            if (nextHop)
+            {
+                nextHop->set(i, i, i);
+            }
+
+            for (const auto& neighbor : graph.getNeighbors(i))
+            {
+                // Keep the lightest of any parallel edges; a negative
+                // self-loop shows up as a negative diagonal entry.
+                if (neighbor.second < rowI[neighbor.first])
+                {
+                    rowI[neighbor.first] = neighbor.second;
+
+                    if (nextHop)
+                    {
+                        nextHop->set(i, neighbor.first, neighbor.first);
+                    }
+                }
+            }
+        }
+    }
+
+    // The (k, i, j) triple loop. HopType is the NextHopMatrix storage type;
+    // it is ignored when `nextHop` is null.
+    template <typename HopType>
+    static void relaxAllPairs(DistanceMatrix &distances, NextHopMatrix *nextHop)
+    {
+        int n = distances.size();
+
+        for (int k = 0; k < n; ++k)
+        {
+            const int* rowK = distances.row(k);
+
+            for (int i = 0; i < n; ++i)
+            {
+                int* rowI = distances.row(i);
+                int distIK = rowI[k];
+
+                if (distIK == INF)
+                {
+                    continue;
+                }
+
+                if (!nextHop)
+                {
+                    for (int j = 0; j < n; ++j)
+                    {
+                        if (rowK[j] != INF && distIK + rowK[j] < rowI[j])
+                        {
+                            rowI[j] = distIK + rowK[j];
+                        }
+                    }
+                    continue;
+                }
+
+                HopType* hopI = nextHop->template rowAs<HopType>(i);
+                HopType hopIK = hopI[k];
+
+                for (int j = 0; j < n; ++j)
+                {
+                    if (rowK[j] != INF && distIK + rowK[j] < rowI[j])
+                    {
+                        rowI[j] = distIK + rowK[j];
+                        hopI[j] = hopIK;
+                    }
+                }
+            }
+        }
+    }
+
+    static bool hasNegativeCycle(const DistanceMatrix &distances)
+    {
+        for (int i = 0; i < distances.size(); ++i)
+        {
+            if (distances.at(i, i) < 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+//-------------------- INCREMENTAL ALL-PAIRS RESULT --------------------
+// An edge that was added or whose weight decreased.
+struct EdgeUpdate
+{
+    int source;
+    int destination;
+    int weight;
+};
+
+/**
+ * All-pairs shortest-path result that can be kept current as edges are
+ * added or made cheaper, without rerunning Floyd-Warshall.
+ * Each update relaxes every pair (i, j) through the changed edge (u, v):
+ *     dist[i][j] = min(dist[i][j], dist[i][u] + w + dist[v][j])
+ * which is exact in O(V^2) as long as the previous matrix was exact.
+ * Edge removals and weight increases still need a full compute().
+ */
+class AllPairsShortestPaths
+{
+private:
+    DistanceMatrix distances;
+    NextHopMatrix nextHop;
+    bool trackPaths;
+    bool directed;
+    bool negativeCycle;
+    std::vector<int> columnU; // Scratch: dist[*][u] before the update
+    std::vector<int> rowV;    // Scratch: dist[v][*] before the update
+    std::vector<int> hopToU;  // Scratch: nextHop[*][u] before the update
+
+    void relaxThroughEdge(int u, int v, int w)
+    {
+        int n = distances.size();
+
+        if (u == v)
+        {
+            // A self-loop only matters if it is a negative cycle by itself.
+            if (w < 0)
+            {
+                distances.at(u, u) = std::min(distances.at(u, u), w);
+                negativeCycle = true;
+            }
+            return;
+        }
+
+        if (distances.at(u, v) != INF && w >= distances.at(u, v))
+        {
+            return; // Not an improvement, so no pair can improve either.
+        }
+
+        columnU.resize(n);
+        rowV.assign(distances.row(v), distances.row(v) + n);
+        for (int i = 0; i < n; ++i)
+        {
+            columnU[i] = distances.at(i, u);
+        }
+        if (trackPaths)
+        {
+            hopToU.resize(n);
+            for (int i = 0; i < n; ++i)
+            {
+                hopToU[i] = (i == u) ? v : nextHop.get(i, u);
+            }
+        }
+
+        for (int i = 0; i < n; ++i)
+        {
+            if (columnU[i] == INF)
+            {
+                continue;
+            }
+
+            int viaEdge = columnU[i] + w;
+            int* rowI = distances.row(i);
+
+            for (int j = 0; j < n; ++j)
+            {
+                if (rowV[j] != INF && viaEdge + rowV[j] < rowI[j])
+                {
+                    rowI[j] = viaEdge + rowV[j];
+
+                    if (trackPaths)
+                    {
+                        nextHop.set(i, j, hopToU[i]);
+                    }
+                }
+            }
+
+            if (rowI[i] < 0)
+            {
+                negativeCycle = true;
+            }
+        }
+    }
+
+public:
+    AllPairsShortestPaths(bool withPaths = false)
+        : trackPaths(withPaths), directed(true), negativeCycle(false) {}
+
+    /**
+     * Runs Floyd-Warshall from scratch.
+     * Returns `false` if the graph has a negative cycle.
+     */
+    bool compute(const Graph &graph)
+    {
+        directed = graph.isDirected();
+
+        bool ok = trackPaths ? GraphAlgorithms::floydWarshall(graph, distances, nextHop)
+                             : GraphAlgorithms::floydWarshall(graph, distances);
+        negativeCycle = !ok;
+        return ok;
+    }
+
+    /**
+     * Applies one added or cheaper edge (u, v, w) in O(V^2). For an
+     * undirected graph the edge is applied in both directions.
+     * Returns `false` if the matrix now contains a negative cycle; once that
+     * happens the distances are no longer meaningful and stay flagged until
+     * the next compute().
+     */
+    bool applyEdgeDecrease(int u, int v, int w)
+    {
+        int n = distances.size();
+        if (u < 0 || u >= n || v < 0 || v >= n)
+        {
+            throw std::out_of_range("Vertex index out of range in applyEdgeDecrease.");
+        }
+
+        relaxThroughEdge(u, v, w);
+        if (!directed)
+        {
+            relaxThroughEdge(v, u, w);
+        }
+
+        return !negativeCycle;
+    }
+
+    /**
+     * Applies several added or cheaper edges, one O(V^2) pass each.
+     * Returns `false` if a negative cycle exists afterwards.
+     */
+    bool applyEdgeDecreases(const std::vector<EdgeUpdate> &updates)
+    {
+        for (const auto& update : updates)
+        {
+            applyEdgeDecrease(update.source, update.destination, update.weight);
+        }
+
+        return !negativeCycle;
+    }
+
+    bool hasNegativeCycle() const
+    {
+        return negativeCycle;
+    }
+
+    const DistanceMatrix& getDistances() const
+    {
+        return distances;
+    }
+
+    // Only filled when constructed with `withPaths = true`.
+    const NextHopMatrix& getNextHops() const
+    {
+        return nextHop;
+    }
+
+    std::vector<int> reconstructPath(int source, int destination) const
+    {
+        if (!trackPaths)
+        {
+            throw std::logic_error("Path tracking was not enabled for this result.");
+        }
+        return nextHop.reconstructPath(source, destination);
+    }
+};
+
+//-------------------- BINARY DISTANCE-MATRIX I/O --------------------
+// File layout (native byte order):
+//   DistanceMatrixFileHeader, then numVertices rows of numVertices elements.
+//   elementBytes == 4: raw int32 distances, INF stored as INF.
+//   elementBytes == 2: uint16 quantized distances, value = offset + q * scale,
+//                      with q == QUANTIZED_INF meaning "no path". Values are
+//                      rounded to the nearest step, so they read back only
+//                      accurate to +/- scale / 2; chooseQuantization puts 0
+//                      on the grid so zero distances stay exactly zero.
+struct DistanceMatrixFileHeader
+{
+    char magic[4];          // "APSP"
+    uint32_t version;
+    uint32_t elementBytes;  // 4 (int32) or 2 (quantized uint16)
+    uint32_t reserved;
+    uint64_t numVertices;
+    int64_t offset;         // Quantization offset (0 for int32 files)
+    int64_t scale;          // Quantization step (1 for int32 files)
+};
+
+const uint16_t QUANTIZED_INF = 0xFFFF;
+
+/**
+ * Picks offset/scale so every finite distance in `distances` fits in
+ * [0, QUANTIZED_INF - 1] after quantization, with offset a non-positive
+ * multiple of scale: 0 is then a grid point and the diagonal (and any other
+ * zero) reads back exactly, instead of rounding to some nearby negative
+ * value that would look like a negative cycle.
+ */
+void chooseQuantization(const DistanceMatrix& distances, long long& offset, long long& scale)
+{
+    long long minValue = 0, maxValue = 0;
+    bool any = false;
+    int n = distances.size();
+
+    for (int i = 0; i < n; ++i)
+    {
+        const int* row = distances.row(i);
+        for (int j = 0; j < n; ++j)
+        {
+            if (row[j] == INF)
+            {
+                continue;
+            }
+            if (!any || row[j] < minValue) minValue = row[j];
+            if (!any || row[j] > maxValue) maxValue = row[j];
+            any = true;
+        }
+    }
+
+    // The grid must cover [min(minValue, 0), max(maxValue, 0)].
+    const long long low = std::min(minValue, 0LL);
+    const long long high = std::max(maxValue, 0LL);
+    const long long steps = QUANTIZED_INF - 1;
+    scale = std::max(1LL, (high - low + steps - 1) / steps);
+    while (true)
+    {
+        // Round `low` down to a multiple of scale.
+        offset = -((-low + scale - 1) / scale) * scale;
+        if (high - offset <= steps * scale)
+        {
+            break;
+        }
+        ++scale;
+    }
+}
+
+/**
+ * Streams a distance matrix to disk one row at a time, so the producer
+ * never has to hold the whole matrix. Rows must be written in order.
+ */
+class DistanceMatrixWriter
+{
+private:
+    std::ofstream out;
+    int numVertices;
+    int rowsWritten;
+    bool quantized;
+    long long offset;
+    long long scale;
+    std::vector<uint16_t> quantizedRow;
+
+    void writeHeader()
+    {
+        DistanceMatrixFileHeader header;
+        std::memcpy(header.magic, "APSP", 4);
+        header.version = 1;
+        header.elementBytes = quantized ? 2 : 4;
+        header.reserved = 0;
+        header.numVertices = static_cast<uint64_t>(numVertices);
+        header.offset = offset;
+        header.scale = scale;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+public:
+    // Full-precision int32 file.
+    DistanceMatrixWriter(const std::string& path, int vertices)
+        : out(path, std::ios::binary | std::ios::trunc), numVertices(vertices), rowsWritten(0),
+          quantized(false), offset(0), scale(1)
+    {
+        if (!out)
+        {
+            throw std::runtime_error("Cannot open distance matrix file for writing: " + path);
+        }
+        writeHeader();
+    }
+
+    // 16-bit quantized file; see chooseQuantization for picking offset/scale.
+    // Keep offset a multiple of scale, or zero distances will not read back as 0.
+    DistanceMatrixWriter(const std::string& path, int vertices, long long quantOffset, long long quantScale)
+        : out(path, std::ios::binary | std::ios::trunc), numVertices(vertices), rowsWritten(0),
+          quantized(true), offset(quantOffset), scale(quantScale), quantizedRow(vertices)
+    {
+        if (quantScale <= 0)
+        {
+            throw std::invalid_argument("Quantization scale must be positive.");
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Cannot open distance matrix file for writing: " + path);
+        }
+        writeHeader();
+    }
+
+    ~DistanceMatrixWriter()
+    {
+        if (out.is_open())
+        {
+            out.close();
+        }
+    }
+
+    // Appends the next row (numVertices distances). Values outside the
+    // quantized range are clamped to the nearest representable value.
+    void writeRow(const int* row)
+    {
+        if (rowsWritten >= numVertices)
+        {
+            throw std::out_of_range("All rows of the distance matrix have already been written.");
+        }
+
+        if (!quantized)
+        {
+            out.write(reinterpret_cast<const char*>(row), static_cast<std::streamsize>(numVertices) * sizeof(int));
+        }
+        else
+        {
+            for (int j = 0; j < numVertices; ++j)
+            {
+                if (row[j] == INF)
+                {
+                    quantizedRow[j] = QUANTIZED_INF;
+                    continue;
+                }
+                long long q = (static_cast<long long>(row[j]) - offset + scale / 2) / scale;
+                q = std::min<long long>(std::max<long long>(q, 0), QUANTIZED_INF - 1);
+                quantizedRow[j] = static_cast<uint16_t>(q);
+            }
+            out.write(reinterpret_cast<const char*>(quantizedRow.data()),
+                      static_cast<std::streamsize>(numVertices) * sizeof(uint16_t));
+        }
+
+        if (!out)
+        {
+            throw std::runtime_error("Failed to write distance matrix row.");
+        }
+        ++rowsWritten;
+    }
+
+    // Flushes and closes the file. Throws if not every row was written.
+    void close()
+    {
+        if (rowsWritten != numVertices)
+        {
+            throw std::logic_error("Distance matrix file closed before all rows were written.");
+        }
+        out.close();
+        if (!out)
+        {
+            throw std::runtime_error("Failed to finalize distance matrix file.");
+        }
+    }
+};
+
+/**
+ * Writes an in-memory DistanceMatrix to `path`, optionally quantized to 16 bits.
+ */
+void writeDistanceMatrix(const DistanceMatrix& distances, const std::string& path, bool quantize = false)
+{
+    int n = distances.size();
+
+    if (quantize)
+    {
+        long long offset, scale;
+        chooseQuantization(distances, offset, scale);
+        DistanceMatrixWriter writer(path, n, offset, scale);
+        for (int i = 0; i < n; ++i)
+        {
+            writer.writeRow(distances.row(i));
+        }
+        writer.close();
+    }
+    else
+    {
+        DistanceMatrixWriter writer(path, n);
+        for (int i = 0; i < n; ++i)
+        {
+            writer.writeRow(distances.row(i));
+        }
+        writer.close();
+    }
+}
+
+/**
+ * Read-only, memory-mapped view of a file produced by DistanceMatrixWriter.
+ * Pages are loaded by the OS on demand, so consumers can walk rows of a
+ * matrix much larger than RAM.
+ */
+class DistanceMatrixReader
+{
+private:
+    const unsigned char* mapped;
+    size_t mappedBytes;
+    DistanceMatrixFileHeader header;
+    const unsigned char* payload;
+
+    DistanceMatrixReader(const DistanceMatrixReader&) = delete;
+    DistanceMatrixReader& operator=(const DistanceMatrixReader&) = delete;
+
+    void unmap()
+    {
+        if (!mapped)
+        {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(mapped);
+#else
+        munmap(const_cast<unsigned char*>(mapped), mappedBytes);
+#endif
+        mapped = nullptr;
+    }
+
+public:
+    explicit DistanceMatrixReader(const std::string& path) : mapped(nullptr), mappedBytes(0), payload(nullptr)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("Cannot open distance matrix file: " + path);
+        }
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx(file, &fileSize);
+        mappedBytes = static_cast<size_t>(fileSize.QuadPart);
+        HANDLE mapping = mappedBytes ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+        if (mapping)
+        {
+            mapped = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping); // The view keeps the mapping alive.
+        }
+        CloseHandle(file);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Cannot open distance matrix file: " + path);
+        }
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            mappedBytes = static_cast<size_t>(st.st_size);
+            void* view = mmap(nullptr, mappedBytes, PROT_READ, MAP_SHARED, fd, 0);
+            if (view != MAP_FAILED)
+            {
+                mapped = static_cast<const unsigned char*>(view);
+                madvise(view, mappedBytes, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(fd);
+#endif
+        if (!mapped)
+        {
+            throw std::runtime_error("Cannot map distance matrix file: " + path);
+        }
+
+        if (mappedBytes < sizeof(header))
+        {
+            unmap();
+            throw std::runtime_error("Distance matrix file is truncated: " + path);
+        }
+        std::memcpy(&header, mapped, sizeof(header));
+        payload = mapped + sizeof(header);
+
+        // The header is untrusted: bound numVertices before multiplying so a
+        // crafted value can't wrap the size check and let reads leave the mapping.
+        bool valid = std::memcmp(header.magic, "APSP", 4) == 0 && header.version == 1 &&
+                     (header.elementBytes == 2 || header.elementBytes == 4) &&
+                     header.numVertices <= static_cast<uint64_t>(std::numeric_limits<int>::max());
+        if (valid && header.numVertices > 0)
+        {
+            uint64_t payloadElements = (mappedBytes - sizeof(header)) / header.elementBytes;
+            valid = header.numVertices <= payloadElements / header.numVertices;
+        }
+        if (!valid)
+        {
+            unmap();
+            throw std::runtime_error("Not a valid distance matrix file: " + path);
+        }
+    }
+
+    ~DistanceMatrixReader()
+    {
+        unmap();
+    }
+
+    int size() const
+    {
+        return static_cast<int>(header.numVertices);
+    }
+
+    bool isQuantized() const
+    {
+        return header.elementBytes == 2;
+    }
+
+    // Zero-copy access to row i of an int32 file; nullptr for quantized files.
+    const int* rowData(int i) const
+    {
+        if (isQuantized())
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<const int*>(payload) + static_cast<size_t>(i) * header.numVertices;
+    }
+
+    // Distance from i to j (dequantized if needed), INF if unreachable.
+    int at(int i, int j) const
+    {
+        if (i < 0 || j < 0 || i >= size() || j >= size())
+        {
+            throw std::out_of_range("Vertex index out of range in DistanceMatrixReader::at.");
+        }
+
+        size_t index = static_cast<size_t>(i) * header.numVertices + j;
+        if (!isQuantized())
+        {
+            int value;
+            std::memcpy(&value, payload + index * sizeof(int), sizeof(int));
+            return value;
+        }
+
+        uint16_t q;
+        std::memcpy(&q, payload + index * sizeof(uint16_t), sizeof(uint16_t));
+        if (q == QUANTIZED_INF)
+        {
+            return INF;
+        }
+        return static_cast<int>(header.offset + static_cast<long long>(q) * header.scale);
+    }
+
+    // Copies row i into `out`, dequantizing if needed.
+    void readRow(int i, std::vector<int>& out) const
+    {
+        if (i < 0 || i >= size())
+        {
+            throw std::out_of_range("Row index out of range in DistanceMatrixReader::readRow.");
+        }
+
+        int n = size();
+        out.resize(n);
+        if (!isQuantized())
+        {
+            std::memcpy(out.data(), rowData(i), static_cast<size_t>(n) * sizeof(int));
+            return;
+        }
+        for (int j = 0; j < n; ++j)
+        {
+            out[j] = at(i, j);
+        }
+    }
 };
 
 //-------------------- MAIN FUNCTION FOR TESTING --------------------
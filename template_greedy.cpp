@@ -4,6 +4,14 @@
 #include <queue>     // Required for std::priority_queue
 #include <string>
 #include <map>       // Required for std::map
+#include <stdexcept>
+#include <functional> // For std::greater
+#include <thread>     // For the parallel job sort
+#include <cstdint>
+#include <limits>
+#include <array>
+#include <fstream>
+#include <exception>
 
 //-------------------- DATA STRUCTURES --------------------
 
@@ -22,6 +30,22 @@ struct Job {
     
 };
 
+// Sort key for weightedJobSchedulingExact: the job's fields copied into a
+// compact record so the sort compares contiguous memory.
+struct JobKey {
+    int weight;
+    int length;
+    int index;
+};
+
+// Reusable scratch space for weightedJobSchedulingExact. Keeping one of
+// these across calls means no allocation once the buffers have grown.
+struct JobScheduleWorkspace {
+    std::vector<JobKey> keys;
+    std::vector<JobKey> buffer; // Merge buffer for the parallel sort
+    std::vector<int> order;     // After a call: job indices in schedule order
+};
+
 // Represents a node in the Huffman Tree
 struct HuffmanNode {
     char data;
@@ -31,6 +55,15 @@ struct HuffmanNode {
     HuffmanNode(char data, int frequency) : data(data), frequency(frequency), left(nullptr), right(nullptr) {}
 };
 
+// Node of a Huffman tree kept in a flat array: children are indices into
+// the same array (-1 for leaves) instead of pointers.
+struct FlatHuffmanNode {
+    char data;
+    long long frequency;
+    int left;
+    int right;
+};
+
 // Comparator for the min-priority queue used in Huffman coding
 struct CompareNodes {
     bool operator()(HuffmanNode* l, HuffmanNode* r) {
@@ -85,6 +118,173 @@ public:
         return selectedActivities;
     }
 
+    /**
+     * High-volume Activity Selection.
+     * Leaves `activities` untouched and copies nothing: works on a permutation
+     * of indices ordered by finish time (counting sort when the finish times
+     * span a small range, comparison sort otherwise), zero-length activities
+     * last among equal finish times.
+     * @param activities All available activities.
+     * @return Indices into `activities` of the selected activities, in finish order.
+     */
+    static std::vector<int> activitySelectionIndices(const std::vector<Activity>& activities)
+    {
+        std::vector<int> order = orderByFinish(activities);
+        std::vector<int> selected;
+
+        bool any = false;
+        int lastFinish = 0;
+        for (int index : order)
+        {
+            if (!any || activities[index].start >= lastFinish)
+            {
+                selected.push_back(index);
+                lastFinish = activities[index].finish;
+                any = true;
+            }
+        }
+
+        return selected;
+    }
+
+    /**
+     * Weighted Interval Scheduling: picks compatible activities (start >=
+     * previous finish) with the largest total value.
+     * Sorts once by finish, finds each interval's last compatible
+     * predecessor by binary search, then runs the O(n) DP and walks it back.
+     * Everything lives in flat arrays indexed by sorted position.
+     * @param activities All available activities.
+     * @param values values[i] is the value of activities[i].
+     * @param chosen If non-null, receives the indices of the chosen activities in finish order.
+     * @return The maximum total value.
+     */
+    static long long weightedIntervalScheduling(const std::vector<Activity>& activities,
+                                                const std::vector<long long>& values,
+                                                std::vector<int>* chosen = nullptr)
+    {
+        if (values.size() != activities.size())
+        {
+            throw std::invalid_argument("Need exactly one value per activity.");
+        }
+
+        const int n = static_cast<int>(activities.size());
+        std::vector<int> order = orderByFinish(activities);
+
+        std::vector<int> finish(n);
+        for (int j = 0; j < n; j++)
+        {
+            finish[j] = activities[order[j]].finish;
+        }
+
+        // predecessor[j]: how many of the first j sorted intervals end by the start of interval j.
+        std::vector<int> predecessor(n);
+        for (int j = 0; j < n; j++)
+        {
+            predecessor[j] = static_cast<int>(std::upper_bound(finish.begin(), finish.begin() + j,
+                                                               activities[order[j]].start) - finish.begin());
+        }
+
+        // best[j]: best total value using only the first j sorted intervals.
+        std::vector<long long> best(n + 1, 0);
+        for (int j = 0; j < n; j++)
+        {
+            best[j + 1] = std::max(best[j], values[order[j]] + best[predecessor[j]]);
+        }
+
+        if (chosen)
+        {
+            chosen->clear();
+            for (int j = n; j > 0;)
+            {
+                if (values[order[j - 1]] + best[predecessor[j - 1]] > best[j - 1])
+                {
+                    chosen->push_back(order[j - 1]);
+                    j = predecessor[j - 1];
+                }
+                else
+                {
+                    j--;
+                }
+            }
+            std::reverse(chosen->begin(), chosen->end());
+        }
+
+        return best[n];
+    }
+
+    /**
+     * Interval Partitioning: assigns every activity to a resource (machine,
+     * room, ...) so that activities sharing a resource are compatible, using
+     * the minimum number of resources.
+     * Activities are taken by start time (zero-length ones first among equal
+     * starts); each one reuses the resource that frees up earliest if it is
+     * already free, otherwise opens a new one.
+     * When all times fall in a small integer range this becomes a bucketed
+     * sweep over time with a stack of free resources and no heap at all.
+     * @param activities All activities to schedule.
+     * @param resourceOf Receives the resource id (0, 1, ...) of each activity.
+     * @return The number of resources used.
+     */
+    static int intervalPartitioning(const std::vector<Activity>& activities, std::vector<int>& resourceOf)
+    {
+        const int n = static_cast<int>(activities.size());
+        resourceOf.assign(n, -1);
+        if (n == 0)
+        {
+            return 0;
+        }
+
+        long long minTime = activities[0].start, maxTime = activities[0].start;
+        for (const auto& activity : activities)
+        {
+            minTime = std::min<long long>(minTime, std::min(activity.start, activity.finish));
+            maxTime = std::max<long long>(maxTime, std::max(activity.start, activity.finish));
+        }
+
+        long long range = maxTime - minTime + 1;
+        if (range <= COUNTING_SORT_SLACK * n + COUNTING_SORT_MIN_BUCKETS)
+        {
+            return intervalPartitioningSweep(activities, minTime, range, resourceOf);
+        }
+
+        std::vector<int> start(n);
+        for (int i = 0; i < n; i++)
+        {
+            start[i] = activities[i].start;
+        }
+        std::vector<int> order = stableOrderByKey(start);
+        // Among equal starts, zero-length activities go first so they can hand
+        // their resource straight on; the others all overlap anyway.
+        partitionRunsBy(order, start, [&activities](int i) { return activities[i].start == activities[i].finish; });
+
+        // Min-heap of {finish time, resource id} for resources in use.
+        std::vector<std::pair<int, int>> busy;
+        std::greater<std::pair<int, int>> later;
+        int resources = 0;
+
+        for (int index : order)
+        {
+            const Activity& activity = activities[index];
+            int resource;
+            if (!busy.empty() && busy.front().first <= activity.start)
+            {
+                resource = busy.front().second;
+                std::pop_heap(busy.begin(), busy.end(), later);
+                busy.pop_back();
+            }
+            else
+            {
+                resource = resources++;
+            }
+
+            resourceOf[index] = resource;
+            busy.push_back({activity.finish, resource});
+            std::push_heap(busy.begin(), busy.end(), later);
+        }
+
+        return resources;
+    }
+
     /**
      * Solves the Job Scheduling problem to minimize the weighted sum of completion times.
      * @param jobs A vector of jobs, each with a weight and a length.
@@ -118,6 +318,90 @@ public:
         return totalWeightedCompletionTime;
     }
 
+    /**
+     * Exact version of weightedJobScheduling (minimizing sum of w_j * C_j).
+     * Ratios are compared by 64-bit cross-multiplication, w_a * l_b > w_b * l_a,
+     * so there is no division and no rounding. The sort works on compact
+     * {weight, length, index} keys, optionally split across threads and
+     * merged. The sum is accumulated in 128 bits where the compiler
+     * supports it, otherwise with checked 64-bit arithmetic.
+     * Jobs with equal ratios are kept in index order (any order among them
+     * gives the same total).
+     * @param jobs The jobs; not modified.
+     * @param workspace Scratch buffers; `workspace.order` receives the schedule.
+     * @param numThreads Threads for the sort (1 = sequential, 0 = all hardware threads).
+     * @return The total weighted completion time.
+     * Throws invalid_argument if a job has length <= 0 or weight < 0, and
+     * overflow_error if the total does not fit in a long long.
+     */
+    static long long weightedJobSchedulingExact(const std::vector<Job>& jobs, JobScheduleWorkspace& workspace,
+                                                unsigned numThreads = 1)
+    {
+        const size_t n = jobs.size();
+        workspace.keys.resize(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            // Cross-multiplied ratios only form a strict weak ordering for
+            // positive lengths: a zero-length job would tie with every job.
+            if (jobs[i].length <= 0 || jobs[i].weight < 0)
+            {
+                throw std::invalid_argument("Jobs need a positive length and a non-negative weight.");
+            }
+            workspace.keys[i] = {jobs[i].weight, jobs[i].length, static_cast<int>(i)};
+        }
+
+        auto before = [](const JobKey& a, const JobKey& b) {
+            long long lhs = static_cast<long long>(a.weight) * b.length;
+            long long rhs = static_cast<long long>(b.weight) * a.length;
+            return lhs > rhs || (lhs == rhs && a.index < b.index);
+        };
+        parallelSort(workspace.keys, workspace.buffer, before, numThreads);
+
+        workspace.order.resize(n);
+        for (size_t k = 0; k < n; k++)
+        {
+            workspace.order[k] = workspace.keys[k].index;
+        }
+
+#ifdef __SIZEOF_INT128__
+        __int128 total = 0;
+        __int128 completion = 0;
+        for (const JobKey& key : workspace.keys)
+        {
+            completion += key.length;
+            total += key.weight * completion;
+        }
+        if (total > std::numeric_limits<long long>::max() || total < std::numeric_limits<long long>::min())
+        {
+            throw std::overflow_error("Weighted completion time does not fit in 64 bits.");
+        }
+        return static_cast<long long>(total);
+#else
+        long long total = 0;
+        long long completion = 0;
+        for (const JobKey& key : workspace.keys)
+        {
+            completion = checkedAdd(completion, key.length);
+            total = checkedAdd(total, checkedMultiply(key.weight, completion));
+        }
+        return total;
+#endif
+    }
+
+    // Convenience overload with a temporary workspace; `order` (if non-null)
+    // receives the job indices in schedule order.
+    static long long weightedJobSchedulingExact(const std::vector<Job>& jobs, std::vector<int>* order = nullptr,
+                                                unsigned numThreads = 1)
+    {
+        JobScheduleWorkspace workspace;
+        long long total = weightedJobSchedulingExact(jobs, workspace, numThreads);
+        if (order)
+        {
+            order->swap(workspace.order);
+        }
+        return total;
+    }
+
     /**
      * Builds a Huffman Tree for data compression.
      * @param frequencies A vector of pairs (character, frequency).
@@ -166,6 +450,1619 @@ public:
 
         return pq.empty() ? nullptr : pq.top(); // Placeholder
     }
+
+    /**
+     * Builds a Huffman Tree in O(n) from frequencies already sorted in
+     * ascending order, using two queues: the leaves in input order, and the
+     * internal nodes, which are created in non-decreasing frequency order.
+     * No heap, no per-node allocation: `nodes` gets the n leaves first
+     * (nodes[i] is the leaf of sortedFrequencies[i]) followed by the n - 1
+     * internal nodes.
+     * @param sortedFrequencies Pairs (character, frequency) in ascending frequency order.
+     * @param nodes Receives the tree.
+     * @return Index of the root in `nodes`, or -1 if there are no symbols.
+     */
+    static int buildHuffmanTreeSorted(const std::vector<std::pair<char, int>>& sortedFrequencies,
+                                      std::vector<FlatHuffmanNode>& nodes)
+    {
+        const int n = static_cast<int>(sortedFrequencies.size());
+        nodes.clear();
+        nodes.reserve(n > 0 ? 2 * n - 1 : 0);
+
+        for (int i = 0; i < n; i++)
+        {
+            if (i > 0 && sortedFrequencies[i].second < sortedFrequencies[i - 1].second)
+            {
+                throw std::invalid_argument("Frequencies must be sorted in ascending order.");
+            }
+            nodes.push_back({sortedFrequencies[i].first, sortedFrequencies[i].second, -1, -1});
+        }
+
+        if (n == 0)
+        {
+            return -1;
+        }
+
+        int nextLeaf = 0;
+        int nextInternal = n;
+        auto takeMin = [&]() {
+            bool leafFirst = nextLeaf < n &&
+                             (nextInternal == static_cast<int>(nodes.size()) ||
+                              nodes[nextLeaf].frequency <= nodes[nextInternal].frequency);
+            return leafFirst ? nextLeaf++ : nextInternal++;
+        };
+
+        for (int merges = 0; merges < n - 1; merges++)
+        {
+            int left = takeMin();
+            int right = takeMin();
+            nodes.push_back({'$', nodes[left].frequency + nodes[right].frequency, left, right});
+        }
+
+        return static_cast<int>(nodes.size()) - 1;
+    }
+
+    /**
+     * In-place Huffman code lengths (Moffat & Katajainen).
+     * Takes frequencies sorted in ascending order and overwrites each one
+     * with the code length of that symbol, without building a tree: the
+     * array itself first holds parent pointers, then internal node depths,
+     * then leaf depths. O(n) time, O(1) extra space.
+     * A single symbol gets length 1 so it can still be encoded.
+     * @param frequencies Ascending frequencies in, code lengths out.
+     */
+    static void huffmanCodeLengthsInPlace(std::vector<long long>& frequencies)
+    {
+        const int n = static_cast<int>(frequencies.size());
+        std::vector<long long>& A = frequencies;
+
+        for (int i = 1; i < n; i++)
+        {
+            if (A[i] < A[i - 1])
+            {
+                throw std::invalid_argument("Frequencies must be sorted in ascending order.");
+            }
+        }
+        if (n == 0)
+        {
+            return;
+        }
+        if (n == 1)
+        {
+            A[0] = 1;
+            return;
+        }
+
+        // Pass 1, left to right: combine weights, leaving parent pointers behind.
+        A[0] += A[1];
+        int root = 0;
+        int leaf = 2;
+        for (int next = 1; next < n - 1; next++)
+        {
+            if (leaf >= n || A[root] < A[leaf])
+            {
+                A[next] = A[root];
+                A[root++] = next;
+            }
+            else
+            {
+                A[next] = A[leaf++];
+            }
+
+            if (leaf >= n || (root < next && A[root] < A[leaf]))
+            {
+                A[next] += A[root];
+                A[root++] = next;
+            }
+            else
+            {
+                A[next] += A[leaf++];
+            }
+        }
+
+        // Pass 2, right to left: turn parent pointers into internal node depths.
+        A[n - 2] = 0;
+        for (int next = n - 3; next >= 0; next--)
+        {
+            A[next] = A[A[next]] + 1;
+        }
+
+        // Pass 3, right to left: turn internal depths into leaf depths.
+        int available = 1;
+        int used = 0;
+        long long depth = 0;
+        root = n - 2;
+        int next = n - 1;
+        while (available > 0)
+        {
+            while (root >= 0 && A[root] == depth)
+            {
+                used++;
+                root--;
+            }
+            while (available > used)
+            {
+                A[next--] = depth;
+                available--;
+            }
+            available = 2 * used;
+            depth++;
+            used = 0;
+        }
+    }
+
+private:
+    // Counting sort is used when max - min finish is at most this many
+    // buckets per activity (plus a fixed allowance).
+    static const long long COUNTING_SORT_SLACK = 4;
+    static const long long COUNTING_SORT_MIN_BUCKETS = 1 << 16;
+
+    /**
+     * Stable sort of key[0..n-1]: returns the indices ordered by (key, index).
+     * Bounded integer keys go through a counting sort in O(n + range).
+     */
+    static std::vector<int> stableOrderByKey(const std::vector<int>& key)
+    {
+        const int n = static_cast<int>(key.size());
+        std::vector<int> order(n);
+        if (n == 0)
+        {
+            return order;
+        }
+
+        auto [minIt, maxIt] = std::minmax_element(key.begin(), key.end());
+        long long minKey = *minIt;
+        long long range = static_cast<long long>(*maxIt) - minKey + 1;
+
+        if (range <= COUNTING_SORT_SLACK * n + COUNTING_SORT_MIN_BUCKETS)
+        {
+            std::vector<int> start(static_cast<size_t>(range) + 1, 0);
+            for (int k : key)
+            {
+                start[k - minKey + 1]++;
+            }
+            for (long long b = 0; b < range; b++)
+            {
+                start[b + 1] += start[b];
+            }
+            for (int i = 0; i < n; i++)
+            {
+                order[start[key[i] - minKey]++] = i;
+            }
+            return order;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(),
+                    [&key](int a, int b) {
+                        return key[a] < key[b] || (key[a] == key[b] && a < b);
+                        });
+        return order;
+    }
+
+    // Below this many elements per thread the job sort stays sequential.
+    static const size_t PARALLEL_SORT_MIN_CHUNK = 1 << 15;
+
+    /**
+     * Sorts `order` with `before`: each thread sorts one contiguous chunk,
+     * then adjacent sorted runs are merged pairwise (in parallel) through
+     * `buffer` until one run is left.
+     */
+    template <typename T, typename Before>
+    static void parallelSort(std::vector<T>& order, std::vector<T>& buffer, Before before, unsigned numThreads)
+    {
+        const size_t n = order.size();
+        if (numThreads == 0)
+        {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        size_t runs = std::min<size_t>(numThreads, n / PARALLEL_SORT_MIN_CHUNK);
+        if (runs <= 1)
+        {
+            std::sort(order.begin(), order.end(), before);
+            return;
+        }
+
+        std::vector<size_t> bounds(runs + 1);
+        for (size_t r = 0; r <= runs; r++)
+        {
+            bounds[r] = n * r / runs;
+        }
+
+        std::vector<std::thread> workers;
+        for (size_t r = 0; r < runs; r++)
+        {
+            workers.emplace_back([&order, &bounds, before, r]() {
+                std::sort(order.begin() + bounds[r], order.begin() + bounds[r + 1], before);
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+
+        buffer.resize(n);
+        while (bounds.size() > 2)
+        {
+            std::vector<size_t> merged;
+            workers.clear();
+            for (size_t r = 0; r + 1 < bounds.size(); r += 2)
+            {
+                merged.push_back(bounds[r]);
+                if (r + 2 < bounds.size())
+                {
+                    workers.emplace_back([&order, &buffer, &bounds, before, r]() {
+                        std::merge(order.begin() + bounds[r], order.begin() + bounds[r + 1],
+                                   order.begin() + bounds[r + 1], order.begin() + bounds[r + 2],
+                                   buffer.begin() + bounds[r], before);
+                    });
+                }
+                else
+                {
+                    // Odd run out: carried over unchanged.
+                    std::copy(order.begin() + bounds[r], order.begin() + bounds[r + 1], buffer.begin() + bounds[r]);
+                }
+            }
+            merged.push_back(n);
+            for (auto& worker : workers)
+            {
+                worker.join();
+            }
+            order.swap(buffer);
+            bounds.swap(merged);
+        }
+    }
+
+#ifndef __SIZEOF_INT128__
+    static long long checkedAdd(long long a, long long b)
+    {
+        if ((b > 0 && a > std::numeric_limits<long long>::max() - b) ||
+            (b < 0 && a < std::numeric_limits<long long>::min() - b))
+        {
+            throw std::overflow_error("Weighted completion time does not fit in 64 bits.");
+        }
+        return a + b;
+    }
+
+    static long long checkedMultiply(long long a, long long b)
+    {
+        if (a != 0 && b != 0)
+        {
+            long long limit = std::numeric_limits<long long>::max();
+            bool sameSign = (a > 0) == (b > 0);
+            unsigned long long ua = a < 0 ? 0ULL - static_cast<unsigned long long>(a) : static_cast<unsigned long long>(a);
+            unsigned long long ub = b < 0 ? 0ULL - static_cast<unsigned long long>(b) : static_cast<unsigned long long>(b);
+            unsigned long long bound = sameSign ? static_cast<unsigned long long>(limit) : static_cast<unsigned long long>(limit) + 1;
+            if (ua > bound / ub)
+            {
+                throw std::overflow_error("Weighted completion time does not fit in 64 bits.");
+            }
+        }
+        return a * b;
+    }
+#endif
+
+    /**
+     * Within each run of equal `key` values in `order`, moves the indices
+     * with first(i) true ahead of the others, keeping both groups in their
+     * current order. One linear pass; only `scratch` grows.
+     */
+    template <typename First>
+    static void partitionRunsBy(std::vector<int>& order, const std::vector<int>& key, First first)
+    {
+        std::vector<int> scratch;
+        for (size_t runStart = 0; runStart < order.size();)
+        {
+            size_t runEnd = runStart;
+            size_t write = runStart;
+            scratch.clear();
+            while (runEnd < order.size() && key[order[runEnd]] == key[order[runStart]])
+            {
+                int index = order[runEnd++];
+                if (first(index))
+                {
+                    order[write++] = index;
+                }
+                else
+                {
+                    scratch.push_back(index);
+                }
+            }
+            std::copy(scratch.begin(), scratch.end(), order.begin() + write);
+            runStart = runEnd;
+        }
+    }
+
+    /**
+     * Bucketed sweep for intervalPartitioning when every time lies in
+     * [minTime, minTime + range). At each time t: free the resources of
+     * activities ending at t, then hand out resources to activities starting
+     * at t (zero-length ones first, freeing theirs again immediately).
+     */
+    static int intervalPartitioningSweep(const std::vector<Activity>& activities, long long minTime,
+                                         long long range, std::vector<int>& resourceOf)
+    {
+        const int n = static_cast<int>(activities.size());
+
+        // CSR-style buckets: activities starting / ending at each time.
+        std::vector<int> startHead(static_cast<size_t>(range) + 1, 0), endHead(static_cast<size_t>(range) + 1, 0);
+        for (const auto& activity : activities)
+        {
+            startHead[activity.start - minTime + 1]++;
+            endHead[activity.finish - minTime + 1]++;
+        }
+        for (long long t = 0; t < range; t++)
+        {
+            startHead[t + 1] += startHead[t];
+            endHead[t + 1] += endHead[t];
+        }
+        std::vector<int> startsAt(n), endsAt(n);
+        {
+            std::vector<int> startCursor(startHead.begin(), startHead.end() - 1);
+            std::vector<int> endCursor(endHead.begin(), endHead.end() - 1);
+            for (int i = 0; i < n; i++)
+            {
+                startsAt[startCursor[activities[i].start - minTime]++] = i;
+                endsAt[endCursor[activities[i].finish - minTime]++] = i;
+            }
+        }
+
+        std::vector<int> freeResources;
+        int resources = 0;
+        auto acquire = [&]() {
+            if (freeResources.empty())
+            {
+                return resources++;
+            }
+            int resource = freeResources.back();
+            freeResources.pop_back();
+            return resource;
+        };
+
+        for (long long t = 0; t < range; t++)
+        {
+            for (int k = endHead[t]; k < endHead[t + 1]; k++)
+            {
+                int i = endsAt[k];
+                if (activities[i].start < activities[i].finish)
+                {
+                    freeResources.push_back(resourceOf[i]);
+                }
+            }
+
+            for (int k = startHead[t]; k < startHead[t + 1]; k++)
+            {
+                int i = startsAt[k];
+                if (activities[i].start == activities[i].finish)
+                {
+                    resourceOf[i] = acquire();
+                    freeResources.push_back(resourceOf[i]);
+                }
+            }
+            for (int k = startHead[t]; k < startHead[t + 1]; k++)
+            {
+                int i = startsAt[k];
+                if (activities[i].start != activities[i].finish)
+                {
+                    resourceOf[i] = acquire();
+                }
+            }
+        }
+
+        return resources;
+    }
+
+    /**
+     * Indices ordered by finish time, ties kept in input order except that
+     * zero-length activities [f, f] go after the others ending at f, so they
+     * can still follow them. Linear after the counting sort.
+     */
+    static std::vector<int> orderByFinish(const std::vector<Activity>& activities)
+    {
+        const size_t n = activities.size();
+        long long minFinish = 0, maxFinish = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            minFinish = i ? std::min<long long>(minFinish, activities[i].finish) : activities[i].finish;
+            maxFinish = i ? std::max<long long>(maxFinish, activities[i].finish) : activities[i].finish;
+        }
+
+        // Fold the zero-length flag into the key as its lowest bit when the
+        // doubled range fits in an int: one counting sort does both orders.
+        std::vector<int> key(n);
+        if (maxFinish - minFinish < (1LL << 30))
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                key[i] = static_cast<int>(2 * (activities[i].finish - minFinish)) +
+                         (activities[i].start == activities[i].finish ? 1 : 0);
+            }
+            return stableOrderByKey(key);
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            key[i] = activities[i].finish;
+        }
+        std::vector<int> order = stableOrderByKey(key);
+        partitionRunsBy(order, key, [&activities](int i) { return activities[i].start != activities[i].finish; });
+        return order;
+    }
+};
+
+/**
+ * Activity Selection over a stream that is already sorted by finish time.
+ * Keeps only the last selected finish time, so memory is O(1) no matter
+ * how many activities flow through.
+ */
+class ActivityStreamSelector
+{
+private:
+    bool any;
+    int lastFinish;
+    long long selectedCount;
+
+public:
+    ActivityStreamSelector() : any(false), lastFinish(0), selectedCount(0) {}
+
+    /**
+     * Offers the next activity of the stream.
+     * @return true if the activity is selected.
+     * Throws invalid_argument if finish times go backwards.
+     */
+    bool offer(const Activity& activity)
+    {
+        if (any && activity.finish < lastFinish)
+        {
+            throw std::invalid_argument("Activity stream is not sorted by finish time.");
+        }
+        if (any && activity.start < lastFinish)
+        {
+            return false;
+        }
+
+        any = true;
+        lastFinish = activity.finish;
+        selectedCount++;
+        return true;
+    }
+
+    long long count() const
+    {
+        return selectedCount;
+    }
+};
+
+/**
+ * Huffman tree stored in one vector of FlatHuffmanNode owned by the object.
+ * Building reserves all 2n - 1 nodes up front, so a tree costs a single
+ * allocation, is freed in one go, and can be rebuilt in place reusing that
+ * storage. Traversals are iterative and write into fixed-size arrays
+ * indexed by the byte value of each symbol.
+ */
+class HuffmanTree
+{
+public:
+    static const int ALPHABET_SIZE = 256;
+    static const int MAX_CODE_LENGTH = 64; // Codes are returned in a uint64_t
+
+private:
+    std::vector<FlatHuffmanNode> nodes;
+    int root;
+
+    // Orders node indices for a min-heap on frequency; ties go to the older node.
+    struct CompareIndices
+    {
+        const std::vector<FlatHuffmanNode>* nodes;
+
+        bool operator()(int a, int b) const
+        {
+            const FlatHuffmanNode& x = (*nodes)[a];
+            const FlatHuffmanNode& y = (*nodes)[b];
+            return x.frequency != y.frequency ? x.frequency > y.frequency : a > b;
+        }
+    };
+
+    struct TraversalEntry
+    {
+        int node;
+        int depth;
+        uint64_t code;
+    };
+
+    /**
+     * Depth-first walk calling visit(symbol, length, code) for every leaf.
+     * The explicit stack never holds more than one entry per leaf, so a
+     * fixed array of ALPHABET_SIZE + 1 entries is enough.
+     */
+    template <typename Visit>
+    void forEachLeaf(Visit visit) const
+    {
+        if (root < 0)
+        {
+            return;
+        }
+        if (nodes[root].left < 0)
+        {
+            // A lone symbol still needs one bit to be written.
+            visit(static_cast<unsigned char>(nodes[root].data), 1, 0);
+            return;
+        }
+
+        std::array<TraversalEntry, ALPHABET_SIZE + 1> stack;
+        int top = 0;
+        stack[top++] = {root, 0, 0};
+        while (top > 0)
+        {
+            TraversalEntry entry = stack[--top];
+            const FlatHuffmanNode& node = nodes[entry.node];
+            if (node.left < 0)
+            {
+                visit(static_cast<unsigned char>(node.data), entry.depth, entry.code);
+                continue;
+            }
+            if (entry.depth >= MAX_CODE_LENGTH)
+            {
+                throw std::overflow_error("Huffman code longer than 64 bits.");
+            }
+            stack[top++] = {node.right, entry.depth + 1, (entry.code << 1) | 1};
+            stack[top++] = {node.left, entry.depth + 1, entry.code << 1};
+        }
+    }
+
+    static void checkAlphabetSize(size_t n)
+    {
+        if (n > static_cast<size_t>(ALPHABET_SIZE))
+        {
+            throw std::invalid_argument("A Huffman tree holds at most 256 symbols.");
+        }
+    }
+
+public:
+    HuffmanTree() : root(-1) {}
+
+    /**
+     * Builds the tree from (character, frequency) pairs in any order,
+     * using a binary heap of node indices held on the stack.
+     * Characters are expected to be distinct.
+     */
+    explicit HuffmanTree(const std::vector<std::pair<char, int>>& frequencies) : root(-1)
+    {
+        build(frequencies);
+    }
+
+    // Rebuilds the tree in place from unsorted frequencies.
+    void build(const std::vector<std::pair<char, int>>& frequencies)
+    {
+        const size_t n = frequencies.size();
+        checkAlphabetSize(n);
+        nodes.clear();
+        nodes.reserve(n > 0 ? 2 * n - 1 : 0);
+        root = -1;
+        if (n == 0)
+        {
+            return;
+        }
+
+        // n is at most ALPHABET_SIZE, so the heap fits in a fixed array and
+        // the nodes reservation stays the only allocation.
+        std::array<int, ALPHABET_SIZE> heap;
+        int* heapEnd = heap.data();
+        for (size_t i = 0; i < n; i++)
+        {
+            nodes.push_back({frequencies[i].first, frequencies[i].second, -1, -1});
+            *heapEnd++ = static_cast<int>(i);
+        }
+
+        CompareIndices compare = {&nodes};
+        std::make_heap(heap.data(), heapEnd, compare);
+        while (heapEnd - heap.data() > 1)
+        {
+            std::pop_heap(heap.data(), heapEnd, compare);
+            int left = *--heapEnd;
+            std::pop_heap(heap.data(), heapEnd, compare);
+            int right = heapEnd[-1];
+            heapEnd[-1] = static_cast<int>(nodes.size());
+            nodes.push_back({'$', nodes[left].frequency + nodes[right].frequency, left, right});
+            std::push_heap(heap.data(), heapEnd, compare);
+        }
+        root = heap[0];
+    }
+
+    /**
+     * Builds the tree in O(n) from frequencies sorted in ascending order,
+     * via GreedyAlgorithms::buildHuffmanTreeSorted.
+     */
+    static HuffmanTree fromSorted(const std::vector<std::pair<char, int>>& sortedFrequencies)
+    {
+        checkAlphabetSize(sortedFrequencies.size());
+        HuffmanTree tree;
+        tree.root = GreedyAlgorithms::buildHuffmanTreeSorted(sortedFrequencies, tree.nodes);
+        return tree;
+    }
+
+    /**
+     * Code length of every symbol, indexed by its byte value (0 = absent).
+     */
+    void codeLengths(std::array<uint8_t, ALPHABET_SIZE>& lengths) const
+    {
+        lengths.fill(0);
+        forEachLeaf([&lengths](unsigned char symbol, int length, uint64_t) {
+            lengths[symbol] = static_cast<uint8_t>(length);
+        });
+    }
+
+    /**
+     * Code bits and lengths of every symbol, indexed by its byte value.
+     * Symbol s is the low lengths[s] bits of codes[s], first bit highest;
+     * left edges are 0 and right edges 1, as in getHuffmanCodes.
+     */
+    void codes(std::array<uint64_t, ALPHABET_SIZE>& codes, std::array<uint8_t, ALPHABET_SIZE>& lengths) const
+    {
+        codes.fill(0);
+        lengths.fill(0);
+        forEachLeaf([&codes, &lengths](unsigned char symbol, int length, uint64_t code) {
+            codes[symbol] = code;
+            lengths[symbol] = static_cast<uint8_t>(length);
+        });
+    }
+
+    bool empty() const
+    {
+        return root < 0;
+    }
+
+    // Index of the root in getNodes(), or -1 for an empty tree.
+    int rootIndex() const
+    {
+        return root;
+    }
+
+    const std::vector<FlatHuffmanNode>& getNodes() const
+    {
+        return nodes;
+    }
+
+    // Drops the tree but keeps the node storage for the next build.
+    void clear()
+    {
+        nodes.clear();
+        root = -1;
+    }
+};
+
+//-------------------- CANONICAL HUFFMAN CODES --------------------
+
+// A canonical prefix code: symbol s is written as the low lengths[s] bits
+// of codes[s], most significant bit first. Length 0 means "no code".
+struct CanonicalHuffmanCode {
+    std::vector<int> lengths;
+    std::vector<uint32_t> codes;
+    int maxLength;
+};
+
+/**
+ * Writes variable-length codes MSB-first through a 64-bit bit buffer,
+ * emitting 32 bits to `out` at a time.
+ */
+class HuffmanBitWriter
+{
+private:
+    std::vector<uint8_t>& out;
+    uint64_t buffer;
+    int count; // Bits held in `buffer`, always < 32 between calls
+    size_t totalBits;
+
+public:
+    explicit HuffmanBitWriter(std::vector<uint8_t>& output) : out(output), buffer(0), count(0), totalBits(0) {}
+
+    // Appends the low `length` bits of `code` (length <= 32).
+    void write(uint32_t code, int length)
+    {
+        buffer = (buffer << length) | code;
+        count += length;
+        totalBits += length;
+        if (count >= 32)
+        {
+            count -= 32;
+            uint32_t word = static_cast<uint32_t>(buffer >> count);
+            out.push_back(static_cast<uint8_t>(word >> 24));
+            out.push_back(static_cast<uint8_t>(word >> 16));
+            out.push_back(static_cast<uint8_t>(word >> 8));
+            out.push_back(static_cast<uint8_t>(word));
+        }
+    }
+
+    // Writes out the remaining bits, zero-padding the last byte.
+    void flush()
+    {
+        while (count >= 8)
+        {
+            count -= 8;
+            out.push_back(static_cast<uint8_t>(buffer >> count));
+        }
+        if (count > 0)
+        {
+            out.push_back(static_cast<uint8_t>(buffer << (8 - count)));
+            count = 0;
+        }
+    }
+
+    size_t bitsWritten() const
+    {
+        return totalBits;
+    }
+};
+
+/**
+ * Reads an MSB-first bit stream through a left-aligned 64-bit window.
+ * Reading past the end yields zero bits.
+ */
+class HuffmanBitReader
+{
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+    uint64_t window; // Next bits, left-aligned
+    int count;       // Valid bits in `window`
+
+public:
+    HuffmanBitReader(const uint8_t* bytes, size_t length)
+        : data(bytes), size(length), position(0), window(0), count(0) {}
+
+    // Tops the window up to at least 57 bits.
+    void refill()
+    {
+        if (position + 8 <= size)
+        {
+            // Fast path: load eight bytes big-endian and keep the whole bytes that fit.
+            const uint8_t* p = data + position;
+            uint64_t next = (static_cast<uint64_t>(p[0]) << 56) | (static_cast<uint64_t>(p[1]) << 48) |
+                            (static_cast<uint64_t>(p[2]) << 40) | (static_cast<uint64_t>(p[3]) << 32) |
+                            (static_cast<uint64_t>(p[4]) << 24) | (static_cast<uint64_t>(p[5]) << 16) |
+                            (static_cast<uint64_t>(p[6]) << 8) | static_cast<uint64_t>(p[7]);
+            window |= next >> count;
+            position += (63 - count) >> 3;
+            count |= 56;
+            return;
+        }
+        while (count <= 56)
+        {
+            uint64_t byte = position < size ? data[position] : 0;
+            position++;
+            window |= byte << (56 - count);
+            count += 8;
+        }
+    }
+
+    // The next k bits (1 <= k <= 32) as an integer; call refill() first.
+    uint32_t peek(int k) const
+    {
+        return static_cast<uint32_t>(window >> (64 - k));
+    }
+
+    void consume(int k)
+    {
+        window <<= k;
+        count -= k;
+    }
+
+    // Bits consumed so far; more than 8 * length means the stream ran out.
+    size_t bitsConsumed() const
+    {
+        return position * 8 - static_cast<size_t>(count);
+    }
+};
+
+class CanonicalHuffman
+{
+public:
+    static constexpr int MAX_CODE_LENGTH = 24;
+    static constexpr int MAX_SYMBOLS = 1 << 16;
+
+    /**
+     * Optimal code lengths subject to a maximum length, by package-merge.
+     * Level 0 is the list of used symbols sorted by frequency; each further
+     * level pairs up the previous level's items into packages and merges
+     * them with the symbols again. The 2n - 2 cheapest items of the last
+     * level decide the lengths: a symbol's length is the number of times it
+     * appears inside them. Only the first 2n - 2 items of each level can
+     * ever be selected, so longer lists are cut there.
+     * @param frequencies frequencies[s] for each symbol s (0 = unused).
+     * @param maxLength Longest allowed code, 1..MAX_CODE_LENGTH.
+     * @return lengths[s] per symbol (0 for unused symbols).
+     */
+    static std::vector<int> lengthLimitedCodeLengths(const std::vector<long long>& frequencies, int maxLength)
+    {
+        if (maxLength < 1 || maxLength > MAX_CODE_LENGTH)
+        {
+            throw std::invalid_argument("Maximum code length must be between 1 and 24.");
+        }
+
+        std::vector<int> lengths(frequencies.size(), 0);
+        std::vector<int> used;
+        for (size_t s = 0; s < frequencies.size(); s++)
+        {
+            if (frequencies[s] < 0)
+            {
+                throw std::invalid_argument("Frequencies must be non-negative.");
+            }
+            if (frequencies[s] > 0)
+            {
+                used.push_back(static_cast<int>(s));
+            }
+        }
+
+        const size_t n = used.size();
+        if (n == 0)
+        {
+            return lengths;
+        }
+        if (n == 1)
+        {
+            lengths[used[0]] = 1;
+            return lengths;
+        }
+        if (n > (static_cast<size_t>(1) << maxLength))
+        {
+            throw std::invalid_argument("Too many symbols for the maximum code length.");
+        }
+
+        std::stable_sort(used.begin(), used.end(),
+                            [&frequencies](int a, int b) { return frequencies[a] < frequencies[b]; });
+
+        struct Item
+        {
+            long long weight;
+            int leaf;  // Symbol for a leaf, -1 for a package
+            int first; // Package: index of its first half in the previous level
+        };
+
+        const size_t keep = 2 * n - 2;
+        std::vector<std::vector<Item>> levels(maxLength);
+        levels[0].reserve(n);
+        for (int symbol : used)
+        {
+            levels[0].push_back({frequencies[symbol], symbol, -1});
+        }
+
+        for (int level = 1; level < maxLength; level++)
+        {
+            const std::vector<Item>& previous = levels[level - 1];
+            std::vector<Item>& current = levels[level];
+            current.reserve(std::min(keep, n + previous.size() / 2));
+
+            size_t leaf = 0;
+            size_t pair = 0;
+            while (current.size() < keep && (leaf < n || pair + 1 < previous.size()))
+            {
+                bool takePackage = pair + 1 < previous.size() &&
+                                   (leaf >= n || previous[pair].weight + previous[pair + 1].weight < frequencies[used[leaf]]);
+                if (takePackage)
+                {
+                    current.push_back({previous[pair].weight + previous[pair + 1].weight, -1, static_cast<int>(pair)});
+                    pair += 2;
+                }
+                else
+                {
+                    current.push_back({frequencies[used[leaf]], used[leaf], -1});
+                    leaf++;
+                }
+            }
+        }
+
+        // Count leaf occurrences under the selected items, level by level.
+        // selected[level] is how many leading items of that level are selected.
+        std::vector<size_t> selected(maxLength, 0);
+        selected[maxLength - 1] = std::min(keep, levels[maxLength - 1].size());
+        for (int level = maxLength - 1; level >= 0; level--)
+        {
+            size_t packages = 0;
+            for (size_t k = 0; k < selected[level]; k++)
+            {
+                const Item& item = levels[level][k];
+                if (item.leaf >= 0)
+                {
+                    lengths[item.leaf]++;
+                }
+                else
+                {
+                    packages++;
+                }
+            }
+            // Packages take their halves from the front of the previous level, in order.
+            if (level > 0)
+            {
+                selected[level - 1] = 2 * packages;
+            }
+        }
+
+        return lengths;
+    }
+
+    /**
+     * Assigns canonical codes to the given lengths: shorter codes first,
+     * and within one length in symbol order.
+     * Throws invalid_argument if the lengths cannot form a prefix code.
+     */
+    static CanonicalHuffmanCode fromLengths(const std::vector<int>& lengths)
+    {
+        if (lengths.size() > static_cast<size_t>(MAX_SYMBOLS))
+        {
+            throw std::invalid_argument("Too many symbols for a canonical Huffman code.");
+        }
+
+        CanonicalHuffmanCode code;
+        code.lengths = lengths;
+        code.codes.assign(lengths.size(), 0);
+        code.maxLength = 0;
+
+        std::vector<uint32_t> lengthCount(MAX_CODE_LENGTH + 1, 0);
+        for (int length : lengths)
+        {
+            if (length < 0 || length > MAX_CODE_LENGTH)
+            {
+                throw std::invalid_argument("Code length out of range.");
+            }
+            if (length > 0)
+            {
+                lengthCount[length]++;
+                code.maxLength = std::max(code.maxLength, length);
+            }
+        }
+
+        // Kraft inequality: sum of 2^-length must not exceed 1.
+        uint64_t kraft = 0;
+        for (int length = 1; length <= MAX_CODE_LENGTH; length++)
+        {
+            kraft += static_cast<uint64_t>(lengthCount[length]) << (MAX_CODE_LENGTH - length);
+        }
+        if (kraft > (static_cast<uint64_t>(1) << MAX_CODE_LENGTH))
+        {
+            throw std::invalid_argument("Code lengths do not form a prefix code.");
+        }
+
+        std::vector<uint32_t> nextCode(MAX_CODE_LENGTH + 1, 0);
+        uint32_t value = 0;
+        for (int length = 1; length <= MAX_CODE_LENGTH; length++)
+        {
+            value = (value + (length > 1 ? lengthCount[length - 1] : 0)) << 1;
+            nextCode[length] = value;
+        }
+        for (size_t symbol = 0; symbol < lengths.size(); symbol++)
+        {
+            if (lengths[symbol] > 0)
+            {
+                code.codes[symbol] = nextCode[lengths[symbol]]++;
+            }
+        }
+
+        return code;
+    }
+
+    // Length-limited canonical code for the given frequencies.
+    static CanonicalHuffmanCode build(const std::vector<long long>& frequencies, int maxLength = 15)
+    {
+        return fromLengths(lengthLimitedCodeLengths(frequencies, maxLength));
+    }
+
+    /**
+     * Encodes `count` symbols with `code`. Symbols without a code throw
+     * invalid_argument. The writer is not flushed.
+     */
+    template <typename Symbol>
+    static void encode(const CanonicalHuffmanCode& code, const Symbol* data, size_t count, HuffmanBitWriter& writer)
+    {
+        const int* lengths = code.lengths.data();
+        const uint32_t* codes = code.codes.data();
+        const size_t alphabet = code.lengths.size();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t symbol = static_cast<size_t>(data[i]);
+            if (symbol >= alphabet || lengths[symbol] == 0)
+            {
+                throw std::invalid_argument("Symbol has no Huffman code.");
+            }
+            writer.write(codes[symbol], lengths[symbol]);
+        }
+    }
+};
+
+/**
+ * Table-driven decoder for a CanonicalHuffmanCode.
+ * The primary table is indexed by the next PRIMARY_BITS bits of input and
+ * each entry holds up to three whole symbols that fit in those bits, so
+ * frequent short codes decode several at a time. Codes longer than the
+ * primary width go through one second-level table per prefix.
+ *
+ * Entry layout (uint64_t):
+ *   bits 0-1   symbol count (0 = link to a second-level table)
+ *   bits 2-7   bits consumed
+ *   bits 8-55  up to three 16-bit symbols
+ *   link:      bits 8-39 second-level offset, bits 40-47 second-level width
+ *              (width 0 marks a bit pattern no code starts with)
+ */
+class HuffmanTableDecoder
+{
+private:
+    static constexpr int PRIMARY_BITS = 11;
+    static constexpr int MAX_SYMBOLS_PER_ENTRY = 3;
+
+    int primaryBits;
+    std::vector<uint64_t> table; // Primary table, then all second-level tables
+    std::vector<int> symbolLength;
+
+    static uint64_t makeEntry(int symbolCount, int bits, const uint32_t* symbols)
+    {
+        uint64_t entry = static_cast<uint64_t>(symbolCount) | (static_cast<uint64_t>(bits) << 2);
+        for (int k = 0; k < symbolCount; k++)
+        {
+            entry |= static_cast<uint64_t>(symbols[k]) << (8 + 16 * k);
+        }
+        return entry;
+    }
+
+public:
+    explicit HuffmanTableDecoder(const CanonicalHuffmanCode& code) : symbolLength(code.lengths)
+    {
+        const int maxLength = code.maxLength;
+        primaryBits = std::max(1, std::min(PRIMARY_BITS, maxLength));
+        const uint32_t primarySize = 1u << primaryBits;
+        const uint32_t mask = primarySize - 1;
+
+        // Single-symbol view of the primary table: symbol and length per slot.
+        std::vector<uint32_t> slotSymbol(primarySize, 0);
+        std::vector<int> slotLength(primarySize, 0);
+        // Longest code behind each primary prefix, for sizing second-level tables.
+        std::vector<int> longestUnder(primarySize, 0);
+
+        for (size_t symbol = 0; symbol < code.lengths.size(); symbol++)
+        {
+            int length = code.lengths[symbol];
+            if (length == 0)
+            {
+                continue;
+            }
+            if (length <= primaryBits)
+            {
+                uint32_t first = code.codes[symbol] << (primaryBits - length);
+                for (uint32_t k = 0; k < (1u << (primaryBits - length)); k++)
+                {
+                    slotSymbol[first + k] = static_cast<uint32_t>(symbol);
+                    slotLength[first + k] = length;
+                }
+            }
+            else
+            {
+                uint32_t prefix = code.codes[symbol] >> (length - primaryBits);
+                longestUnder[prefix] = std::max(longestUnder[prefix], length);
+            }
+        }
+
+        table.assign(primarySize, 0);
+        for (uint32_t index = 0; index < primarySize; index++)
+        {
+            if (slotLength[index] == 0)
+            {
+                continue; // Long code prefix or unused pattern; filled below
+            }
+
+            uint32_t symbols[MAX_SYMBOLS_PER_ENTRY];
+            int symbolCount = 0;
+            int bitsUsed = 0;
+            while (symbolCount < MAX_SYMBOLS_PER_ENTRY)
+            {
+                uint32_t slot = (index << bitsUsed) & mask;
+                int length = slotLength[slot];
+                if (length == 0 || length > primaryBits - bitsUsed)
+                {
+                    break; // The next code doesn't fit in what is left of these bits
+                }
+                symbols[symbolCount++] = slotSymbol[slot];
+                bitsUsed += length;
+            }
+            table[index] = makeEntry(symbolCount, bitsUsed, symbols);
+        }
+
+        for (uint32_t prefix = 0; prefix < primarySize; prefix++)
+        {
+            if (longestUnder[prefix] == 0)
+            {
+                continue;
+            }
+            int width = longestUnder[prefix] - primaryBits;
+            uint64_t offset = table.size();
+            table[prefix] = (offset << 8) | (static_cast<uint64_t>(width) << 40);
+            table.resize(table.size() + (static_cast<size_t>(1) << width), 0);
+        }
+
+        for (size_t symbol = 0; symbol < code.lengths.size(); symbol++)
+        {
+            int length = code.lengths[symbol];
+            if (length <= primaryBits)
+            {
+                continue;
+            }
+            uint32_t prefix = code.codes[symbol] >> (length - primaryBits);
+            uint64_t link = table[prefix];
+            size_t offset = static_cast<size_t>((link >> 8) & 0xFFFFFFFF);
+            int width = static_cast<int>((link >> 40) & 0xFF);
+            int rest = length - primaryBits;
+            uint32_t suffix = code.codes[symbol] & ((1u << rest) - 1);
+            uint32_t first = suffix << (width - rest);
+            uint32_t value = static_cast<uint32_t>(symbol);
+            uint64_t entry = makeEntry(1, length, &value);
+            for (uint32_t k = 0; k < (1u << (width - rest)); k++)
+            {
+                table[offset + first + k] = entry;
+            }
+        }
+    }
+
+    /**
+     * Decodes exactly `count` symbols from `reader` into `out`.
+     * Throws runtime_error on a bit pattern that is not a code.
+     */
+    template <typename Symbol>
+    void decode(HuffmanBitReader& reader, Symbol* out, size_t count) const
+    {
+        size_t produced = 0;
+        while (produced < count)
+        {
+            reader.refill();
+            uint64_t entry = table[reader.peek(primaryBits)];
+            int symbolCount = static_cast<int>(entry & 3);
+
+            if (symbolCount == 0)
+            {
+                int width = static_cast<int>((entry >> 40) & 0xFF);
+                if (width == 0)
+                {
+                    throw std::runtime_error("Corrupt Huffman stream.");
+                }
+                size_t offset = static_cast<size_t>((entry >> 8) & 0xFFFFFFFF);
+                entry = table[offset + (reader.peek(primaryBits + width) & ((1u << width) - 1))];
+                symbolCount = static_cast<int>(entry & 3);
+                if (symbolCount == 0)
+                {
+                    throw std::runtime_error("Corrupt Huffman stream.");
+                }
+            }
+
+            if (static_cast<size_t>(symbolCount) <= count - produced)
+            {
+                for (int k = 0; k < symbolCount; k++)
+                {
+                    out[produced++] = static_cast<Symbol>((entry >> (8 + 16 * k)) & 0xFFFF);
+                }
+                reader.consume(static_cast<int>((entry >> 2) & 63));
+            }
+            else
+            {
+                // Only the last few symbols are wanted: consume just their bits
+                // so the reader stays positioned right after them.
+                while (produced < count)
+                {
+                    uint32_t symbol = static_cast<uint32_t>(entry >> 8) & 0xFFFF;
+                    out[produced++] = static_cast<Symbol>(symbol);
+                    reader.consume(symbolLength[symbol]);
+                    entry >>= 16;
+                }
+            }
+        }
+    }
+
+    void decode(const uint8_t* data, size_t bytes, std::vector<uint16_t>& out, size_t count) const
+    {
+        HuffmanBitReader reader(data, bytes);
+        out.resize(count);
+        decode(reader, out.data(), count);
+    }
+};
+
+//-------------------- STREAMING HUFFMAN COMPRESSION --------------------
+
+/**
+ * Block-based Huffman compressor for byte streams.
+ *
+ * Format (all integers little-endian):
+ *   "HUF1", uint32 block size
+ *   per block: uint32 raw size, uint32 payload size, payload
+ *   a block with raw size 0 ends the stream
+ * Payload: one mode byte, then either the raw bytes (STORED) or 128 bytes
+ * of 4-bit canonical code lengths for symbols 0..255 followed by the
+ * MSB-first bit stream (HUFFMAN).
+ *
+ * Every block carries its own code, so blocks are compressed and
+ * decompressed independently; up to numThreads blocks are in flight at
+ * once, which bounds memory to about 2 * numThreads * blockSize.
+ */
+class HuffmanStreamCompressor
+{
+private:
+    static constexpr uint8_t MODE_STORED = 0;
+    static constexpr uint8_t MODE_HUFFMAN = 1;
+    static constexpr int MAX_BLOCK_CODE_LENGTH = 15; // Fits a 4-bit length field
+    static constexpr size_t LENGTH_TABLE_BYTES = 128;
+
+    size_t blockSize;
+    unsigned numThreads;
+
+    static void putUint32(std::vector<uint8_t>& out, uint32_t value)
+    {
+        for (int k = 0; k < 4; k++)
+        {
+            out.push_back(static_cast<uint8_t>(value >> (8 * k)));
+        }
+    }
+
+    static uint32_t getUint32(const uint8_t* bytes)
+    {
+        return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+               (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    }
+
+    static bool readExactly(std::istream& in, uint8_t* bytes, size_t count)
+    {
+        in.read(reinterpret_cast<char*>(bytes), static_cast<std::streamsize>(count));
+        return static_cast<size_t>(in.gcount()) == count;
+    }
+
+    /**
+     * Byte histogram using four interleaved sub-tables, so consecutive equal
+     * bytes update different counters instead of serialising on one.
+     */
+    static std::vector<long long> histogram(const uint8_t* data, size_t count)
+    {
+        std::vector<uint32_t> tables(4 * 256, 0);
+        uint32_t* t0 = tables.data();
+        uint32_t* t1 = t0 + 256;
+        uint32_t* t2 = t1 + 256;
+        uint32_t* t3 = t2 + 256;
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            t0[data[i]]++;
+            t1[data[i + 1]]++;
+            t2[data[i + 2]]++;
+            t3[data[i + 3]]++;
+        }
+        for (; i < count; i++)
+        {
+            t0[data[i]]++;
+        }
+
+        std::vector<long long> frequencies(256);
+        for (int s = 0; s < 256; s++)
+        {
+            frequencies[s] = static_cast<long long>(t0[s]) + t1[s] + t2[s] + t3[s];
+        }
+        return frequencies;
+    }
+
+    // Compresses one block into its payload (mode byte onwards).
+    static void compressBlock(const std::vector<uint8_t>& raw, std::vector<uint8_t>& payload)
+    {
+        payload.clear();
+        CanonicalHuffmanCode code =
+            CanonicalHuffman::build(histogram(raw.data(), raw.size()), MAX_BLOCK_CODE_LENGTH);
+
+        payload.reserve(1 + LENGTH_TABLE_BYTES + raw.size());
+        payload.push_back(MODE_HUFFMAN);
+        for (size_t s = 0; s < 256; s += 2)
+        {
+            payload.push_back(static_cast<uint8_t>(code.lengths[s] | (code.lengths[s + 1] << 4)));
+        }
+        HuffmanBitWriter writer(payload);
+        CanonicalHuffman::encode(code, raw.data(), raw.size(), writer);
+        writer.flush();
+
+        if (payload.size() >= 1 + raw.size())
+        {
+            // Incompressible block: store it as is.
+            payload.assign(1, MODE_STORED);
+            payload.insert(payload.end(), raw.begin(), raw.end());
+        }
+    }
+
+    // Restores `rawSize` bytes from one block's payload.
+    static void decompressBlock(const std::vector<uint8_t>& payload, size_t rawSize, std::vector<uint8_t>& raw)
+    {
+        raw.resize(rawSize);
+        if (payload.empty())
+        {
+            throw std::runtime_error("Corrupt Huffman stream: empty block payload.");
+        }
+
+        if (payload[0] == MODE_STORED)
+        {
+            if (payload.size() != 1 + rawSize)
+            {
+                throw std::runtime_error("Corrupt Huffman stream: stored block size mismatch.");
+            }
+            std::copy(payload.begin() + 1, payload.end(), raw.begin());
+            return;
+        }
+        if (payload[0] != MODE_HUFFMAN || payload.size() < 1 + LENGTH_TABLE_BYTES)
+        {
+            throw std::runtime_error("Corrupt Huffman stream: bad block header.");
+        }
+
+        std::vector<int> lengths(256);
+        for (size_t s = 0; s < 256; s += 2)
+        {
+            lengths[s] = payload[1 + s / 2] & 0x0F;
+            lengths[s + 1] = payload[1 + s / 2] >> 4;
+        }
+
+        CanonicalHuffmanCode code;
+        try
+        {
+            code = CanonicalHuffman::fromLengths(lengths);
+        }
+        catch (const std::invalid_argument&)
+        {
+            throw std::runtime_error("Corrupt Huffman stream: invalid code lengths.");
+        }
+        if (code.maxLength == 0)
+        {
+            throw std::runtime_error("Corrupt Huffman stream: block has no codes.");
+        }
+
+        // Every symbol takes at least the shortest code length, so a payload
+        // too small for rawSize symbols is rejected before decoding.
+        const size_t bitBytes = payload.size() - 1 - LENGTH_TABLE_BYTES;
+        int shortest = MAX_BLOCK_CODE_LENGTH;
+        for (int length : lengths)
+        {
+            if (length > 0)
+            {
+                shortest = std::min(shortest, length);
+            }
+        }
+        if (rawSize > bitBytes * 8 / static_cast<size_t>(shortest))
+        {
+            throw std::runtime_error("Corrupt Huffman stream: truncated block.");
+        }
+
+        HuffmanTableDecoder decoder(code);
+        HuffmanBitReader reader(payload.data() + 1 + LENGTH_TABLE_BYTES, bitBytes);
+        decoder.decode(reader, raw.data(), rawSize);
+
+        // The reader pads with zero bits past the end, so reaching past the
+        // payload means the block was cut short. The encoder writes exactly
+        // the bytes it needs, so anything else is corrupt too.
+        if ((reader.bitsConsumed() + 7) / 8 != bitBytes)
+        {
+            throw std::runtime_error("Corrupt Huffman stream: block length does not match its data.");
+        }
+    }
+
+    // Runs job(i) for i in [0, count), one thread per job when there are several.
+    template <typename Job>
+    static void runBlocks(size_t count, Job job)
+    {
+        if (count <= 1)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                job(i);
+            }
+            return;
+        }
+
+        std::vector<std::thread> workers;
+        std::vector<std::exception_ptr> errors(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            workers.emplace_back([&job, &errors, i]() {
+                try
+                {
+                    job(i);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        for (auto& error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+    static constexpr size_t MAX_BLOCK_SIZE = 1 << 30;
+
+    /**
+     * @param blockBytes Uncompressed bytes per block.
+     * @param threads Blocks processed at once (0 = hardware concurrency).
+     */
+    explicit HuffmanStreamCompressor(size_t blockBytes = DEFAULT_BLOCK_SIZE, unsigned threads = 1)
+        : blockSize(blockBytes), numThreads(threads)
+    {
+        if (blockSize == 0 || blockSize > MAX_BLOCK_SIZE)
+        {
+            throw std::invalid_argument("Block size must be between 1 byte and 1 GiB.");
+        }
+        if (numThreads == 0)
+        {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+    /**
+     * Compresses everything readable from `in` into `out`.
+     * @return Number of uncompressed bytes consumed.
+     */
+    unsigned long long compress(std::istream& in, std::ostream& out) const
+    {
+        std::vector<uint8_t> header = {'H', 'U', 'F', '1'};
+        putUint32(header, static_cast<uint32_t>(blockSize));
+        out.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+        std::vector<std::vector<uint8_t>> raw(numThreads);
+        std::vector<std::vector<uint8_t>> payloads(numThreads);
+        unsigned long long total = 0;
+        bool done = false;
+
+        while (!done)
+        {
+            size_t filled = 0;
+            while (filled < numThreads)
+            {
+                raw[filled].resize(blockSize);
+                in.read(reinterpret_cast<char*>(raw[filled].data()), static_cast<std::streamsize>(blockSize));
+                raw[filled].resize(static_cast<size_t>(in.gcount()));
+                if (raw[filled].empty())
+                {
+                    done = true;
+                    break;
+                }
+                total += raw[filled].size();
+                filled++;
+                if (!in)
+                {
+                    done = true;
+                    break;
+                }
+            }
+
+            runBlocks(filled, [&raw, &payloads](size_t i) { compressBlock(raw[i], payloads[i]); });
+
+            for (size_t i = 0; i < filled; i++)
+            {
+                std::vector<uint8_t> blockHeader;
+                putUint32(blockHeader, static_cast<uint32_t>(raw[i].size()));
+                putUint32(blockHeader, static_cast<uint32_t>(payloads[i].size()));
+                out.write(reinterpret_cast<const char*>(blockHeader.data()), 8);
+                out.write(reinterpret_cast<const char*>(payloads[i].data()),
+                          static_cast<std::streamsize>(payloads[i].size()));
+            }
+        }
+
+        std::vector<uint8_t> terminator;
+        putUint32(terminator, 0);
+        putUint32(terminator, 0);
+        out.write(reinterpret_cast<const char*>(terminator.data()), 8);
+        if (!out)
+        {
+            throw std::runtime_error("Failed to write compressed stream.");
+        }
+        return total;
+    }
+
+    /**
+     * Decompresses a stream written by compress().
+     * Throws runtime_error on malformed or truncated input.
+     * @return Number of uncompressed bytes written.
+     */
+    unsigned long long decompress(std::istream& in, std::ostream& out) const
+    {
+        uint8_t header[8];
+        if (!readExactly(in, header, 8) || header[0] != 'H' || header[1] != 'U' || header[2] != 'F' || header[3] != '1')
+        {
+            throw std::runtime_error("Not a Huffman stream.");
+        }
+        const size_t streamBlockSize = getUint32(header + 4);
+        if (streamBlockSize == 0 || streamBlockSize > MAX_BLOCK_SIZE)
+        {
+            throw std::runtime_error("Corrupt Huffman stream: bad block size.");
+        }
+        // A Huffman payload is at most 15 bits per byte plus the length table.
+        const size_t maxPayload = 1 + LENGTH_TABLE_BYTES + (streamBlockSize * MAX_BLOCK_CODE_LENGTH + 7) / 8;
+
+        std::vector<std::vector<uint8_t>> payloads(numThreads);
+        std::vector<std::vector<uint8_t>> raw(numThreads);
+        std::vector<size_t> rawSizes(numThreads);
+        unsigned long long total = 0;
+        bool done = false;
+
+        while (!done)
+        {
+            size_t filled = 0;
+            while (filled < numThreads)
+            {
+                uint8_t blockHeader[8];
+                if (!readExactly(in, blockHeader, 8))
+                {
+                    throw std::runtime_error("Corrupt Huffman stream: truncated block header.");
+                }
+                size_t rawSize = getUint32(blockHeader);
+                size_t payloadSize = getUint32(blockHeader + 4);
+                if (rawSize == 0)
+                {
+                    done = true;
+                    break;
+                }
+                if (rawSize > streamBlockSize || payloadSize > maxPayload)
+                {
+                    throw std::runtime_error("Corrupt Huffman stream: block too large.");
+                }
+                payloads[filled].resize(payloadSize);
+                if (!readExactly(in, payloads[filled].data(), payloadSize))
+                {
+                    throw std::runtime_error("Corrupt Huffman stream: truncated block.");
+                }
+                rawSizes[filled] = rawSize;
+                filled++;
+            }
+
+            runBlocks(filled, [&payloads, &rawSizes, &raw](size_t i) {
+                decompressBlock(payloads[i], rawSizes[i], raw[i]);
+            });
+
+            for (size_t i = 0; i < filled; i++)
+            {
+                out.write(reinterpret_cast<const char*>(raw[i].data()), static_cast<std::streamsize>(raw[i].size()));
+                total += raw[i].size();
+            }
+        }
+
+        if (!out)
+        {
+            throw std::runtime_error("Failed to write decompressed stream.");
+        }
+        return total;
+    }
+
+    // File-to-file convenience wrappers around compress() and decompress().
+    unsigned long long compressFile(const std::string& inputPath, const std::string& outputPath) const
+    {
+        std::ifstream in(inputPath, std::ios::binary);
+        std::ofstream out(outputPath, std::ios::binary);
+        if (!in || !out)
+        {
+            throw std::runtime_error("Cannot open files for compression.");
+        }
+        return compress(in, out);
+    }
+
+    unsigned long long decompressFile(const std::string& inputPath, const std::string& outputPath) const
+    {
+        std::ifstream in(inputPath, std::ios::binary);
+        std::ofstream out(outputPath, std::ios::binary);
+        if (!in || !out)
+        {
+            throw std::runtime_error("Cannot open files for decompression.");
+        }
+        return decompress(in, out);
+    }
 };
 
 //-------------------- HELPER & MAIN FUNCTION --------------------
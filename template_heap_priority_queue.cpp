@@ -5,6 +5,79 @@
 #include <iostream>
 #include <vector>
 #include <stdexcept>
+#include <functional>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+
+//-------------------- BOTTOM-UP HEAPSORT --------------------
+// Moves the hole at `hole` down to a leaf along the path of larger children,
+// then sifts `value` back up (but not above `top`). Real inputs send most
+// values near the bottom, so this needs about half the comparisons of the
+// classic sift-down that tests `value` against every level (Floyd).
+template <typename RandomIt, typename Compare>
+void bottomUpSiftDown(RandomIt first,
+                      typename std::iterator_traits<RandomIt>::difference_type top,
+                      typename std::iterator_traits<RandomIt>::difference_type hole,
+                      typename std::iterator_traits<RandomIt>::difference_type length,
+                      typename std::iterator_traits<RandomIt>::value_type value,
+                      Compare& comp) {
+    typedef typename std::iterator_traits<RandomIt>::difference_type Diff;
+
+    Diff child = 2 * hole + 2;
+    while (child < length) {
+        if (comp(first[child], first[child - 1])) {
+            child--;
+        }
+        first[hole] = std::move(first[child]);
+        hole = child;
+        child = 2 * hole + 2;
+    }
+    if (child == length) {
+        // Only a left child on the last level
+        first[hole] = std::move(first[child - 1]);
+        hole = child - 1;
+    }
+
+    while (hole > top) {
+        Diff parent = (hole - 1) / 2;
+        if (!comp(first[parent], value)) {
+            break;
+        }
+        first[hole] = std::move(first[parent]);
+        hole = parent;
+    }
+    first[hole] = std::move(value);
+}
+
+// In-place heapsort of [first, last) into ascending order under `comp`.
+// No allocation and no recursion; O(n log n) worst case.
+template <typename RandomIt, typename Compare>
+void heapSortRange(RandomIt first, RandomIt last, Compare comp) {
+    typedef typename std::iterator_traits<RandomIt>::difference_type Diff;
+    typedef typename std::iterator_traits<RandomIt>::value_type Value;
+
+    const Diff n = last - first;
+    if (n < 2) {
+        return;
+    }
+
+    for (Diff i = n / 2 - 1; i >= 0; i--) {
+        Value value = std::move(first[i]);
+        bottomUpSiftDown(first, i, i, n, std::move(value), comp);
+    }
+    for (Diff end = n - 1; end > 0; end--) {
+        Value value = std::move(first[end]);
+        first[end] = std::move(first[0]);
+        bottomUpSiftDown(first, Diff(0), Diff(0), end, std::move(value), comp);
+    }
+}
+
+template <typename RandomIt>
+void heapSortRange(RandomIt first, RandomIt last) {
+    heapSortRange(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
 
 //-------------------- BINARY HEAP (MAX HEAP) --------------------
 class MaxHeap {
@@ -39,12 +112,40 @@ private:
     void swim(int index) {
         // TODO: Implement swim function
         // Compare with parent and swap if needed, continue until heap property is restored
-        while (index > 0 && array[parent(index) < array[index]]) {
+        while (index > 0 && array[parent(index)] < array[index]) {
             swap(array[index], array[parent(index)]);
             index = parent(index);
         }
     }
 
+    // Smallest batch for which insertBatch prefers a bulk heapify
+    static const int BULK_INSERT_MIN = 16;
+
+    // Restores heap order after elements were appended at [oldSize, size):
+    // sinks every ancestor of the new slots, one level at a time from the
+    // bottom, which is Floyd's buildHeap restricted to the affected subtrees.
+    void heapifyAppended(int oldSize) {
+        if (size - oldSize < 1) {
+            return;
+        }
+        if (oldSize == 0) {
+            for (int i = (size / 2) - 1; i >= 0; i--) {
+                sink(i, size);
+            }
+            return;
+        }
+
+        int low = oldSize;
+        int high = size - 1;
+        do {
+            low = parent(low);
+            high = parent(high);
+            for (int i = high; i >= low; i--) {
+                sink(i, size);
+            }
+        } while (low > 0);
+    }
+
     // Move an element down to its correct position (for deletion)
     void sink(int index, int heapSize) {
         // TODO: Implement sink function
@@ -189,6 +290,78 @@ public:
         }
     }
 
+    // Add `count` values at once
+    // Should throw overflow_error if they don't all fit
+    void insertBatch(const int* values, int count) {
+        if (count < 0) {
+            throw std::invalid_argument("Batch size must be non-negative");
+        }
+        if (count > capacity - size) {
+            throw std::overflow_error("Heap is full");
+        }
+
+        int oldSize = size;
+        for (int i = 0; i < count; i++) {
+            array[size++] = values[i];
+        }
+
+        // A swim costs up to log(size) each; once the batch is a sizeable
+        // share of the heap, re-sinking just the ancestors of the new slots
+        // is cheaper (O(count + log size) overall).
+        if (count >= BULK_INSERT_MIN && count * 8 >= oldSize) {
+            heapifyAppended(oldSize);
+        } else {
+            for (int i = oldSize; i < size; i++) {
+                swim(i);
+            }
+        }
+    }
+
+    // Add every element of `other` to this heap, rebuilding in O(n)
+    // `other` is left unchanged
+    // Should throw overflow_error if the combined heap doesn't fit
+    void merge(const MaxHeap& other) {
+        if (other.size > capacity - size) {
+            throw std::overflow_error("Heap is full");
+        }
+
+        int oldSize = size;
+        for (int i = 0; i < other.size; i++) {
+            array[size + i] = other.array[i];
+        }
+        size += other.size;
+        heapifyAppended(oldSize);
+    }
+
+    // Remove the k largest elements, writing them to out[0..k) in
+    // descending order
+    // Should throw underflow_error if the heap has fewer than k elements
+    void popBatch(int k, int* out) {
+        if (k < 0) {
+            throw std::invalid_argument("Batch size must be non-negative");
+        }
+        if (k > size) {
+            throw std::underflow_error("Heap is empty");
+        }
+
+        if (k == size) {
+            // Taking everything: sort in place and read it back to front
+            heapSortRange(array, array + size, std::less<int>());
+            for (int i = 0; i < k; i++) {
+                out[i] = array[size - 1 - i];
+            }
+            size = 0;
+            return;
+        }
+
+        std::less<int> ascending;
+        for (int i = 0; i < k; i++) {
+            out[i] = array[0];
+            size--;
+            bottomUpSiftDown(array, 0, 0, size, array[size], ascending);
+        }
+    }
+
     // Print the heap (for debugging)
     void printHeap() {
         // TODO: Implement printHeap function
@@ -204,20 +377,11 @@ public:
         // TODO: Implement heapSort function
         // 1. Build a max heap from the array
         // 2. Repeatedly extract the maximum and place at the end
-        MaxHeap tempHeap(n);
-        tempHeap.buildHeap(arr, n);
-
-        for (int i = n - 1; i > 0; i--) {
-            int temp = tempHeap.array[0];
-            tempHeap.array[0] = tempHeap.array[i];
-            tempHeap.array[i] = temp;
-
-            tempHeap.sink(0, i);
-        }
-
-        for (int i = 0; i < n; i++) {
-            arr[i] = tempHeap.array[i];
+        // Sorted in place: no temporary heap, no copies in or out
+        if (n < 0) {
+            throw std::invalid_argument("Array size must be non-negative");
         }
+        heapSortRange(arr, arr + n, std::less<int>());
     }
 };
 
@@ -272,6 +436,420 @@ public:
     }
 };
 
+//-------------------- D-ARY HEAP --------------------
+// Generic heap over any movable T. Like std::priority_queue, top() is the
+// element that compares greatest under Compare: std::less<T> gives a max
+// heap, std::greater<T> a min heap. D children per node (D = 4 or 8 keeps
+// all children of a small T in one or two cache lines and halves the depth
+// compared with a binary heap).
+template <typename T, typename Compare = std::less<T>, int D = 4>
+class DaryHeap {
+    static_assert(D >= 2, "A heap needs at least two children per node");
+
+private:
+    // Smallest batch for which pushBatch prefers a bulk heapify
+    static const size_t BULK_PUSH_MIN = 16;
+
+    std::vector<T> data;
+    Compare compare;
+
+    static size_t parentOf(size_t i) {
+        return (i - 1) / D;
+    }
+
+    static size_t firstChildOf(size_t i) {
+        return D * i + 1;
+    }
+
+    // Index of the highest-priority child among [first, end)
+    size_t bestChild(size_t first, size_t end) const {
+        size_t best = first;
+        for (size_t c = first + 1; c < end; c++) {
+            if (compare(data[best], data[c])) {
+                best = c;
+            }
+        }
+        return best;
+    }
+
+    // Moves the hole at `index` up until `value` fits, then drops it in.
+    // Parents slide down into the hole instead of being swapped.
+    void siftUp(size_t index, T value) {
+        while (index > 0) {
+            size_t p = parentOf(index);
+            if (!compare(data[p], value)) {
+                break;
+            }
+            data[index] = std::move(data[p]);
+            index = p;
+        }
+        data[index] = std::move(value);
+    }
+
+    // Moves the hole at `index` down until `value` fits, then drops it in.
+    void siftDown(size_t index, T value) {
+        const size_t n = data.size();
+        while (true) {
+            size_t first = firstChildOf(index);
+            if (first >= n) {
+                break;
+            }
+            // Full families (all but at most one) take the fixed-D loop, which unrolls
+            size_t best = first + D <= n ? bestChild(first, first + D) : bestChild(first, n);
+            if (!compare(value, data[best])) {
+                break;
+            }
+            data[index] = std::move(data[best]);
+            index = best;
+        }
+        data[index] = std::move(value);
+    }
+
+    // Re-sinks the ancestors of the elements appended at [oldSize, size()),
+    // level by level from the bottom; a full heapify when the heap was empty
+    void heapifyAppended(size_t oldSize) {
+        if (oldSize == 0) {
+            heapify();
+            return;
+        }
+        if (oldSize >= data.size()) {
+            return;
+        }
+
+        size_t low = oldSize;
+        size_t high = data.size() - 1;
+        do {
+            low = parentOf(low);
+            high = parentOf(high);
+            for (size_t i = high + 1; i-- > low;) {
+                T value = std::move(data[i]);
+                siftDown(i, std::move(value));
+            }
+        } while (low > 0);
+    }
+
+    // Floyd's bottom-up heap construction, O(n)
+    void heapify() {
+        if (data.size() < 2) {
+            return;
+        }
+        for (size_t i = parentOf(data.size() - 1) + 1; i-- > 0;) {
+            T value = std::move(data[i]);
+            siftDown(i, std::move(value));
+        }
+    }
+
+public:
+    explicit DaryHeap(const Compare& comp = Compare()) : compare(comp) {}
+
+    // Builds a heap from `items` in O(n)
+    explicit DaryHeap(std::vector<T> items, const Compare& comp = Compare())
+        : data(std::move(items)), compare(comp) {
+        heapify();
+    }
+
+    bool isEmpty() const {
+        return data.empty();
+    }
+
+    size_t getSize() const {
+        return data.size();
+    }
+
+    void reserve(size_t capacity) {
+        data.reserve(capacity);
+    }
+
+    void clear() {
+        data.clear();
+    }
+
+    void push(const T& value) {
+        data.emplace_back(value);
+        T moved = std::move(data.back());
+        siftUp(data.size() - 1, std::move(moved));
+    }
+
+    void push(T&& value) {
+        data.emplace_back(std::move(value));
+        T moved = std::move(data.back());
+        siftUp(data.size() - 1, std::move(moved));
+    }
+
+    // Constructs the element in place from `args`
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        data.emplace_back(std::forward<Args>(args)...);
+        T moved = std::move(data.back());
+        siftUp(data.size() - 1, std::move(moved));
+    }
+
+    // Adds every element of [first, last); bulk-heapifies when the batch is
+    // large next to the heap, otherwise sifts each element up
+    template <typename InputIt>
+    void pushBatch(InputIt first, InputIt last) {
+        const size_t oldSize = data.size();
+        data.insert(data.end(), first, last);
+        const size_t count = data.size() - oldSize;
+
+        if (count >= BULK_PUSH_MIN && count * 8 >= oldSize) {
+            heapifyAppended(oldSize);
+        } else {
+            for (size_t i = oldSize; i < data.size(); i++) {
+                T value = std::move(data[i]);
+                siftUp(i, std::move(value));
+            }
+        }
+    }
+
+    // Moves every element of `other` into this heap with an O(n) rebuild;
+    // `other` is left empty
+    void merge(DaryHeap&& other) {
+        if (&other == this) {
+            return;
+        }
+        if (data.empty()) {
+            data.swap(other.data);
+        } else {
+            const size_t oldSize = data.size();
+            data.reserve(oldSize + other.data.size());
+            std::move(other.data.begin(), other.data.end(), std::back_inserter(data));
+            other.data.clear();
+            heapifyAppended(oldSize);
+        }
+    }
+
+    // Removes the k highest-priority elements, writing them to `out` in
+    // priority order
+    // Should throw underflow_error if the heap has fewer than k elements
+    template <typename OutputIt>
+    OutputIt popBatch(size_t k, OutputIt out) {
+        if (k > data.size()) {
+            throw std::underflow_error("Heap is empty");
+        }
+        for (size_t i = 0; i < k; i++) {
+            *out = pop();
+            ++out;
+        }
+        return out;
+    }
+
+    // Highest-priority element
+    // Should throw underflow_error if heap is empty
+    const T& top() const {
+        if (data.empty()) {
+            throw std::underflow_error("Heap is empty");
+        }
+        return data[0];
+    }
+
+    // Removes and returns the highest-priority element
+    // Should throw underflow_error if heap is empty
+    T pop() {
+        if (data.empty()) {
+            throw std::underflow_error("Heap is empty");
+        }
+        T result = std::move(data[0]);
+        T last = std::move(data.back());
+        data.pop_back();
+        if (!data.empty()) {
+            // The old last element nearly always belongs near the bottom, so walk the
+            // hole all the way down first and then bring the element back up.
+            const size_t n = data.size();
+            size_t hole = 0;
+            while (true) {
+                size_t first = firstChildOf(hole);
+                if (first >= n) {
+                    break;
+                }
+                size_t best = first + D <= n ? bestChild(first, first + D) : bestChild(first, n);
+                data[hole] = std::move(data[best]);
+                hole = best;
+            }
+            siftUp(hole, std::move(last));
+        }
+        return result;
+    }
+};
+
+//-------------------- INDEXED PRIORITY QUEUE --------------------
+// Addressable binary heap. insert() returns a handle that stays valid while
+// the element is in the queue, however it moves inside the heap, so an
+// element can be updated or erased in O(log n) without searching for it.
+// Slots of removed elements are recycled, but each reuse bumps the slot's
+// generation, which is part of the handle: a handle kept after its element
+// left the queue never matches the slot's new occupant.
+// Ordering follows DaryHeap: top() compares greatest under Compare.
+template <typename T, typename Compare = std::less<T>>
+class IndexedPriorityQueue {
+public:
+    // Low 32 bits: slot; high 32 bits: generation of the slot
+    typedef uint64_t Handle;
+
+private:
+    std::vector<int> heap;            // Heap order, holding slots
+    std::vector<T> values;            // values[slot]
+    std::vector<int> position;        // position[slot] in `heap`, -1 if free
+    std::vector<uint32_t> generation; // Bumped every time a slot is freed
+    std::vector<int> freeSlots;
+    Compare compare;
+
+    static int slotOf(Handle h) {
+        return static_cast<int>(h & 0xFFFFFFFFu);
+    }
+
+    Handle handleOf(int slot) const {
+        return (static_cast<Handle>(generation[slot]) << 32) | static_cast<uint32_t>(slot);
+    }
+
+    bool higher(int a, int b) const {
+        return compare(values[b], values[a]);
+    }
+
+    void place(int index, int slot) {
+        heap[index] = slot;
+        position[slot] = index;
+    }
+
+    void siftUp(int index) {
+        int slot = heap[index];
+        while (index > 0) {
+            int p = (index - 1) / 2;
+            if (!higher(slot, heap[p])) {
+                break;
+            }
+            place(index, heap[p]);
+            index = p;
+        }
+        place(index, slot);
+    }
+
+    void siftDown(int index) {
+        const int n = static_cast<int>(heap.size());
+        int slot = heap[index];
+        while (true) {
+            int child = 2 * index + 1;
+            if (child >= n) {
+                break;
+            }
+            if (child + 1 < n && higher(heap[child + 1], heap[child])) {
+                child++;
+            }
+            if (!higher(heap[child], slot)) {
+                break;
+            }
+            place(index, heap[child]);
+            index = child;
+        }
+        place(index, slot);
+    }
+
+    // Slot of `h`; throws out_of_range unless `h` is in the queue
+    int checkedSlot(Handle h) const {
+        if (!contains(h)) {
+            throw std::out_of_range("Invalid priority queue handle");
+        }
+        return slotOf(h);
+    }
+
+    // Takes the element at heap position `index` out of the heap. The value
+    // is moved out of its slot so resources it owns are released now rather
+    // than when the slot is reused.
+    void removeAtPosition(int index) {
+        int removed = heap[index];
+        int last = heap.back();
+        heap.pop_back();
+        static_cast<void>(T(std::move(values[removed])));
+        position[removed] = -1;
+        generation[removed]++;
+        freeSlots.push_back(removed);
+
+        if (removed != last) {
+            place(index, last);
+            siftUp(index);
+            siftDown(position[last]);
+        }
+    }
+
+public:
+    explicit IndexedPriorityQueue(const Compare& comp = Compare()) : compare(comp) {}
+
+    bool isEmpty() const {
+        return heap.empty();
+    }
+
+    int getSize() const {
+        return static_cast<int>(heap.size());
+    }
+
+    // True if `h` refers to an element currently in the queue
+    bool contains(Handle h) const {
+        size_t slot = static_cast<size_t>(slotOf(h));
+        return slot < position.size() && position[slot] >= 0 &&
+               generation[slot] == static_cast<uint32_t>(h >> 32);
+    }
+
+    // Adds value and returns its handle
+    Handle insert(T value) {
+        int slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            values[slot] = std::move(value);
+        } else {
+            slot = static_cast<int>(values.size());
+            values.push_back(std::move(value));
+            position.push_back(-1);
+            generation.push_back(0);
+        }
+        heap.push_back(slot);
+        position[slot] = static_cast<int>(heap.size()) - 1;
+        siftUp(position[slot]);
+        return handleOf(slot);
+    }
+
+    // Replaces the value of `h` and restores heap order (increase or decrease key)
+    // Should throw out_of_range if the handle is not in the queue
+    void update(Handle h, T value) {
+        int slot = checkedSlot(h);
+        values[slot] = std::move(value);
+        siftUp(position[slot]);
+        siftDown(position[slot]);
+    }
+
+    // Removes the element of `h` from the queue
+    // Should throw out_of_range if the handle is not in the queue
+    void erase(Handle h) {
+        removeAtPosition(position[checkedSlot(h)]);
+    }
+
+    // Value currently stored for `h`
+    // Should throw out_of_range if the handle is not in the queue
+    const T& valueOf(Handle h) const {
+        return values[checkedSlot(h)];
+    }
+
+    // Handle of the highest-priority element
+    // Should throw underflow_error if queue is empty
+    Handle top() const {
+        if (heap.empty()) {
+            throw std::underflow_error("Priority queue is empty");
+        }
+        return handleOf(heap[0]);
+    }
+
+    // Removes the highest-priority element and returns its value
+    // Should throw underflow_error if queue is empty
+    T pop() {
+        if (heap.empty()) {
+            throw std::underflow_error("Priority queue is empty");
+        }
+        T value = std::move(values[heap[0]]);
+        removeAtPosition(0);
+        return value;
+    }
+};
+
 //-------------------- TESTING FUNCTION --------------------
 // This function will test your implementation
 // Do not modify this function!